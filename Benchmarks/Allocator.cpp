@@ -0,0 +1,113 @@
+/*!
+ * \file Allocator.cpp
+ * \brief
+ *      Compares subscriber churn on events using std::allocator, the shared default EventPool
+ *      and an arena EventPool. Each round unhooks a random callback and hooks a new one, every
+ *      other one a lambda too large for a Delegate's in place storage, then invokes.
+ *      Prints comma separated results: allocator, order, callbacks, nanoseconds per round,
+ *      system allocations per round once warmed up
+ *
+ *      Built by the AllocatorBenchmark target
+ */
+#include "Events.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace
+{
+  size_t systemAllocations = 0; //!< Calls to operator new, counted to show the steady state
+
+  struct Object
+  {
+    uint64_t value = 0;
+    void Tick(int x) { value += x; }
+  };
+
+  template<typename EventType>
+  void Churn(EventType &event, std::vector<Object> &objects, std::vector<EVENT_HANDLE> &handles, size_t rounds, std::mt19937 &random)
+  {
+    uint64_t padding[6] = {};
+    for (size_t round = 0; round < rounds; ++round)
+    {
+      size_t i = random() % handles.size();
+      event.Unhook(handles[i]);
+      if (round & 1)
+        handles[i] = event.Hook(objects[i], &Object::Tick);
+      else
+        handles[i] = event.Hook([object = &objects[i], padding](int x) { object->value += x + padding[0]; });
+      event.Invoke(1);
+    }
+  }
+
+  template<typename EventType>
+  void Run(const char *name, EventType &event, size_t size)
+  {
+    std::mt19937 random(1234);
+    std::vector<Object> objects(size);
+    std::vector<EVENT_HANDLE> handles;
+    for (Object &object : objects)
+      handles.emplace_back(event.Hook(object, &Object::Tick));
+
+    size_t rounds = std::max<size_t>(1000, 2000000 / size);
+    Churn(event, objects, handles, rounds, random);
+
+    size_t allocations = systemAllocations;
+    auto start = std::chrono::steady_clock::now();
+    Churn(event, objects, handles, rounds, random);
+    auto end = std::chrono::steady_clock::now();
+
+    std::printf("%s,%s,%zu,%.2f,%.3f\n", name, EventType::Ordered ? "ordered" : "unordered", size,
+                std::chrono::duration<double, std::nano>(end - start).count() / double(rounds),
+                double(systemAllocations - allocations) / double(rounds));
+  }
+
+  template<bool Ordered>
+  void RunAll(size_t size)
+  {
+    using Signature = void(int);
+    {
+      Event<Signature, Ordered> event;
+      Run("std::allocator", event, size);
+    }
+    {
+      Event<Signature, Ordered, EventPoolAllocator<Call<Signature>>> event;
+      Run("default_pool", event, size);
+    }
+    {
+      EventPool arena;
+      Event<Signature, Ordered, EventPoolAllocator<Call<Signature>>> event{ EventPoolAllocator<Call<Signature>>(arena) };
+      Run("arena_pool", event, size);
+    }
+  }
+}
+
+void* operator new(size_t bytes)
+{
+  ++systemAllocations;
+  if (void *block = std::malloc(bytes ? bytes : 1))
+    return block;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *block) noexcept
+{
+  std::free(block);
+}
+
+void operator delete(void *block, size_t) noexcept
+{
+  std::free(block);
+}
+
+int main()
+{
+  std::printf("allocator,order,callbacks,ns_per_round,allocations_per_round\n");
+  for (size_t size : { 10, 1000, 100000 })
+  {
+    RunAll<true>(size);
+    RunAll<false>(size);
+  }
+  return 0;
+}
@@ -0,0 +1,451 @@
+/*!
+ * \file Events.cpp
+ * \brief
+ *      Times hooking, invoking and unhooking an Event against a std::vector<std::function> baseline,
+ *      for call lists of 1 to 1M callbacks, ordered and unordered, with free function, member
+ *      function and lambda callbacks.
+ *
+ *      Prints comma separated results, one line per case:
+ *          benchmark,order,callback,size,events_ns,baseline_ns
+ *      Times are nanoseconds per operation: per invoke, per hook, per unhook or per churn round.
+ *      The baseline column is empty where the baseline is quadratic and the size too large.
+ *
+ *      The range cases hook with Reserve and HookRange, or unhook with UnhookRange, and have no baseline.
+ *      The once case hooks with HookOnce and times the hooks plus the invoke that clears them.
+ *      The batch case invokes BatchSize payloads with InvokeBatch, callbacks outer, against the
+ *      baseline invoking them one by one, and the queue case enqueues BatchSize invokes on an
+ *      EventQueue and dispatches them. Both report nanoseconds per payload.
+ *
+ *      Usage: EventsBenchmark [max size]
+ */
+#include "Events.hpp"
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+  constexpr size_t FreeCount = 1024;          //!< Distinct free functions, unordered events reject duplicates
+  constexpr size_t QuadraticLimit = 10000;    //!< Largest size a linear search baseline runs at
+  constexpr size_t OperationsPerCase = 4000000; //!< Callbacks or hooks timed per case
+  constexpr size_t BatchSize = 64;            //!< Payloads per InvokeBatch or Dispatch
+
+  uint64_t sink = 0; //!< Written by the free functions so the calls are not removed
+
+  struct Object
+  {
+    uint64_t value = 0;
+    void Tick(int x) { value += x; }
+    void Other(int x) { value -= x; }
+    void Third(int x) { value ^= x; }
+  };
+
+  template<size_t I>
+  void Free(int x)
+  {
+    sink += x + I;
+  }
+
+  template<size_t ...I>
+  constexpr std::array<void(*)(int), sizeof...(I)> MakeFrees(std::index_sequence<I...>)
+  {
+    return { &Free<I>... };
+  }
+
+  constexpr auto frees = MakeFrees(std::make_index_sequence<FreeCount>());
+
+  enum class Kind { Free, Member, Lambda };
+
+  const char* Name(Kind kind)
+  {
+    switch (kind)
+    {
+      case Kind::Free:   return "free";
+      case Kind::Member: return "member";
+      default:           return "lambda";
+    }
+  }
+
+  template<typename Fn>
+  double Time(size_t operations, Fn &&fn)
+  {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / double(operations ? operations : 1);
+  }
+
+  //! Baseline a hand written event would use, unhooking by searching for an id
+  struct Baseline
+  {
+    std::vector<std::function<void(int)>> functions;
+    std::vector<size_t> ids;
+
+    void Hook(std::function<void(int)> function, size_t id)
+    {
+      functions.emplace_back(std::move(function));
+      ids.emplace_back(id);
+    }
+
+    void Invoke(int x) const
+    {
+      for (const auto &function : functions)
+        function(x);
+    }
+
+    void Unhook(size_t id, bool ordered)
+    {
+      size_t index = size_t(std::find(ids.begin(), ids.end(), id) - ids.begin());
+      if (ordered)
+      {
+        functions.erase(functions.begin() + index);
+        ids.erase(ids.begin() + index);
+      }
+      else
+      {
+        functions[index] = std::move(functions.back());
+        ids[index] = ids.back();
+        functions.pop_back();
+        ids.pop_back();
+      }
+    }
+  };
+
+  template<bool Ordered>
+  class Suite
+  {
+      using EventType = Event<void(int), Ordered>;
+      using QueueType = EventQueue<void(int), Ordered>;
+
+    public:
+      Suite(Kind kind, size_t size) : kind_(kind), size_(size), objects_(size + size / 100 + 1)
+      {}
+
+      void Run()
+      {
+        Print("invoke", TimeInvoke(), TimeBaselineInvoke());
+        Print("hook", TimeHook(), TimeBaselineHook());
+        Print("unhook", TimeUnhook(), size_ <= QuadraticLimit ? TimeBaselineUnhook() : -1);
+        Print("churn", TimeChurn(), size_ <= QuadraticLimit ? TimeBaselineChurn() : -1);
+        Print("unhook_range", TimeUnhookRange(), -1);
+        Print("once", TimeOnce(), -1);
+        Print("batch", TimeBatch(), TimeBaselineBatch());
+        Print("queue", TimeQueue(), -1);
+        if (kind_ == Kind::Member)
+        {
+          Print("hook_range", TimeHookRange(), -1);
+          Print("unhook_class", TimeUnhookClass(), size_ <= QuadraticLimit ? TimeBaselineUnhookClass() : -1);
+          Print("unhook_cluster", TimeUnhookCluster(), -1);
+        }
+      }
+
+    private:
+      Kind kind_;
+      size_t size_;
+      std::vector<Object> objects_;
+      std::mt19937 random_{ 1234 };
+
+      void Print(const char *benchmark, double events, double baseline) const
+      {
+        std::printf("%s,%s,%s,%zu,%.2f,", benchmark, Ordered ? "ordered" : "unordered", Name(kind_), size_, events);
+        if (baseline >= 0) std::printf("%.2f", baseline);
+        std::printf("\n");
+      }
+
+      size_t Repeats(size_t perRepeat) const
+      {
+        return std::max<size_t>(1, OperationsPerCase / std::max<size_t>(1, perRepeat));
+      }
+
+      EVENT_HANDLE Hook(EventType &event, size_t i)
+      {
+        switch (kind_)
+        {
+          case Kind::Free:   return event.Hook(frees[i % FreeCount]);
+          case Kind::Member: return event.Hook(objects_[i], &Object::Tick);
+          default:           return event.Hook([object = &objects_[i]](int x) { object->value += x; });
+        }
+      }
+
+      EVENT_HANDLE HookOnce(EventType &event, size_t i)
+      {
+        switch (kind_)
+        {
+          case Kind::Free:   return event.HookOnce(frees[i % FreeCount]);
+          case Kind::Member: return event.HookOnce(objects_[i], &Object::Tick);
+          default:           return event.HookOnce([object = &objects_[i]](int x) { object->value += x; });
+        }
+      }
+
+      std::function<void(int)> Function(size_t i)
+      {
+        switch (kind_)
+        {
+          case Kind::Free:   return frees[i % FreeCount];
+          case Kind::Member: return [object = &objects_[i]](int x) { object->Tick(x); };
+          default:           return [object = &objects_[i]](int x) { object->value += x; };
+        }
+      }
+
+      std::vector<EVENT_HANDLE> Fill(EventType &event)
+      {
+        std::vector<EVENT_HANDLE> handles;
+        for (size_t i = 0; i < size_; ++i)
+          handles.emplace_back(Hook(event, i));
+        return handles;
+      }
+
+      void Fill(Baseline &baseline)
+      {
+        for (size_t i = 0; i < size_; ++i)
+          baseline.Hook(Function(i), i);
+      }
+
+      double TimeInvoke()
+      {
+        EventType event;
+        Fill(event);
+        size_t repeats = Repeats(size_);
+        return Time(repeats, [&]() { for (size_t i = 0; i < repeats; ++i) event.Invoke(int(i)); });
+      }
+
+      double TimeBaselineInvoke()
+      {
+        Baseline baseline;
+        Fill(baseline);
+        size_t repeats = Repeats(size_);
+        return Time(repeats, [&]() { for (size_t i = 0; i < repeats; ++i) baseline.Invoke(int(i)); });
+      }
+
+      double TimeBatch()
+      {
+        EventType event;
+        Fill(event);
+        std::vector<std::tuple<int>> payloads;
+        for (size_t i = 0; i < BatchSize; ++i)
+          payloads.emplace_back(int(i));
+        size_t repeats = Repeats(size_ * BatchSize);
+        return Time(repeats * BatchSize, [&]() { for (size_t i = 0; i < repeats; ++i) event.InvokeBatch(payloads); });
+      }
+
+      double TimeBaselineBatch()
+      {
+        Baseline baseline;
+        Fill(baseline);
+        size_t repeats = Repeats(size_ * BatchSize);
+        return Time(repeats * BatchSize, [&]()
+        {
+          for (size_t i = 0; i < repeats; ++i)
+            for (size_t payload = 0; payload < BatchSize; ++payload)
+              baseline.Invoke(int(payload));
+        });
+      }
+
+      //! Enqueues a batch of invokes, then dispatches them
+      double TimeQueue()
+      {
+        QueueType queue;
+        Fill(queue);
+        size_t repeats = Repeats(size_ * BatchSize);
+        return Time(repeats * BatchSize, [&]()
+        {
+          for (size_t i = 0; i < repeats; ++i)
+          {
+            for (size_t payload = 0; payload < BatchSize; ++payload)
+              queue.Enqueue(int(payload));
+            queue.Dispatch();
+          }
+        });
+      }
+
+      double TimeHook()
+      {
+        size_t repeats = Repeats(size_);
+        std::vector<EventType> events(repeats);
+        return Time(repeats * size_, [&]() { for (auto &event : events) for (size_t i = 0; i < size_; ++i) Hook(event, i); });
+      }
+
+      double TimeBaselineHook()
+      {
+        size_t repeats = Repeats(size_);
+        std::vector<Baseline> baselines(repeats);
+        return Time(repeats * size_, [&]() { for (auto &baseline : baselines) for (size_t i = 0; i < size_; ++i) baseline.Hook(Function(i), i); });
+      }
+
+      double TimeUnhook()
+      {
+        EventType event;
+        std::vector<EVENT_HANDLE> handles = Fill(event);
+        std::shuffle(handles.begin(), handles.end(), random_);
+        return Time(size_, [&]() { for (EVENT_HANDLE handle : handles) event.Unhook(handle); });
+      }
+
+      double TimeUnhookRange()
+      {
+        EventType event;
+        std::vector<EVENT_HANDLE> handles = Fill(event);
+        std::shuffle(handles.begin(), handles.end(), random_);
+        return Time(size_, [&]() { event.UnhookRange(handles.begin(), handles.end()); });
+      }
+
+      //! Hooks one-shot callbacks, then invokes once, unhooking them all
+      double TimeOnce()
+      {
+        size_t repeats = Repeats(size_);
+        EventType event;
+        return Time(repeats * size_, [&]()
+        {
+          for (size_t repeat = 0; repeat < repeats; ++repeat)
+          {
+            for (size_t i = 0; i < size_; ++i)
+              HookOnce(event, i);
+            event.Invoke(int(repeat));
+          }
+        });
+      }
+
+      double TimeHookRange()
+      {
+        size_t repeats = Repeats(size_);
+        std::vector<EventType> events(repeats);
+        std::vector<EVENT_HANDLE> handles(size_);
+        return Time(repeats * size_, [&]()
+        {
+          for (auto &event : events)
+          {
+            event.Reserve(size_);
+            event.HookRange(objects_.begin(), objects_.begin() + size_, &Object::Tick, handles.begin());
+          }
+        });
+      }
+
+      double TimeBaselineUnhook()
+      {
+        Baseline baseline;
+        Fill(baseline);
+        std::vector<size_t> ids(baseline.ids);
+        std::shuffle(ids.begin(), ids.end(), random_);
+        return Time(size_, [&]() { for (size_t id : ids) baseline.Unhook(id, Ordered); });
+      }
+
+      //! Replaces 1% of the call list, then invokes it
+      double TimeChurn()
+      {
+        EventType event;
+        std::vector<EVENT_HANDLE> handles = Fill(event);
+        size_t replace = size_ / 100 + 1;
+        size_t rounds = Repeats(size_ + replace * 16);
+        size_t next = size_;
+        return Time(rounds, [&]()
+        {
+          for (size_t round = 0; round < rounds; ++round)
+          {
+            for (size_t i = 0; i < replace; ++i)
+            {
+              EVENT_HANDLE &handle = handles[random_() % handles.size()];
+              event.Unhook(handle);
+              handle = Hook(event, next++ % objects_.size());
+            }
+            event.Invoke(int(round));
+          }
+        });
+      }
+
+      double TimeBaselineChurn()
+      {
+        Baseline baseline;
+        Fill(baseline);
+        std::vector<size_t> ids(baseline.ids);
+        size_t replace = size_ / 100 + 1;
+        size_t rounds = Repeats(size_ + replace * 16);
+        size_t next = size_;
+        return Time(rounds, [&]()
+        {
+          for (size_t round = 0; round < rounds; ++round)
+          {
+            for (size_t i = 0; i < replace; ++i)
+            {
+              size_t &id = ids[random_() % ids.size()];
+              baseline.Unhook(id, Ordered);
+              id = next;
+              baseline.Hook(Function(next++ % objects_.size()), id);
+            }
+            baseline.Invoke(int(round));
+          }
+        });
+      }
+
+      //! Hooks three methods of each object, then unhooks the objects one by one
+      double TimeUnhookClass()
+      {
+        EventType event;
+        size_t objects = (size_ + 2) / 3;
+        for (size_t i = 0; i < objects; ++i)
+        {
+          event.Hook(objects_[i], &Object::Tick);
+          event.Hook(objects_[i], &Object::Other);
+          event.Hook(objects_[i], &Object::Third);
+        }
+        std::vector<size_t> order(objects);
+        for (size_t i = 0; i < objects; ++i) order[i] = i;
+        std::shuffle(order.begin(), order.end(), random_);
+        return Time(objects, [&]() { for (size_t i : order) event.UnhookClass(objects_[i]); });
+      }
+
+      double TimeBaselineUnhookClass()
+      {
+        Baseline baseline;
+        size_t objects = (size_ + 2) / 3;
+        for (size_t i = 0; i < objects; ++i)
+          for (int method = 0; method < 3; ++method)
+            baseline.Hook(Function(i), i);
+        std::vector<size_t> order(objects);
+        for (size_t i = 0; i < objects; ++i) order[i] = i;
+        std::shuffle(order.begin(), order.end(), random_);
+        return Time(objects, [&]()
+        {
+          for (size_t id : order)
+            for (int method = 0; method < 3; ++method)
+              baseline.Unhook(id, Ordered);
+        });
+      }
+
+      //! Hooks three methods of each object as a cluster, then unhooks the clusters one by one
+      double TimeUnhookCluster()
+      {
+        EventType event;
+        size_t objects = (size_ + 2) / 3;
+        std::vector<EVENT_HANDLE> clusters;
+        for (size_t i = 0; i < objects; ++i)
+          clusters.emplace_back(event.HookMethodCluster(objects_[i], &Object::Tick, &Object::Other, &Object::Third));
+        std::shuffle(clusters.begin(), clusters.end(), random_);
+        return Time(objects, [&]() { for (EVENT_HANDLE cluster : clusters) event.UnhookCluster(cluster); });
+      }
+  };
+
+  template<bool Ordered>
+  void RunAll(size_t maxSize)
+  {
+    for (Kind kind : { Kind::Free, Kind::Member, Kind::Lambda })
+      for (size_t size = 1; size <= maxSize; size *= 10)
+      {
+        if (!Ordered && kind == Kind::Free && size > FreeCount) break;
+        Suite<Ordered>(kind, size).Run();
+      }
+  }
+}
+
+int main(int argc, char **argv)
+{
+  size_t maxSize = argc > 1 ? size_t(std::strtoull(argv[1], nullptr, 10)) : 1000000;
+
+  std::printf("benchmark,order,callback,size,events_ns,baseline_ns\n");
+  RunAll<true>(maxSize);
+  RunAll<false>(maxSize);
+  return sink == 42 ? 1 : 0;
+}
@@ -0,0 +1,67 @@
+/*!
+ * \file InvokeParallel.cpp
+ * \brief
+ *      Scales a parallel invoke of an unordered event from one thread to the hardware concurrency.
+ *      Prints comma separated results: threads, callbacks, grain, nanoseconds per invoke, speedup
+ *
+ *      Built by the InvokeParallelBenchmark target, or g++ -std=c++17 -O2 -pthread -I.. InvokeParallel.cpp
+ */
+#include "Events.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+struct Agent
+{
+  float position = 0;
+  float velocity = 1;
+
+  void Tick(float dt)
+  {
+    // A little work per callback, as a simulation step would have
+    for (int i = 0; i < 16; ++i)
+      velocity = std::sqrt(velocity * velocity + dt);
+    position += velocity * dt;
+  }
+};
+
+static double Measure(Event<void(float), false> &event, EventThreadPool &pool, int repeats)
+{
+  event.InvokeParallel(pool, 0.001f);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeats; ++i)
+    event.InvokeParallel(pool, 0.001f);
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / repeats;
+}
+
+int main()
+{
+  const size_t counts[] = { 1000, 100000, 1000000 };
+  const size_t grains[] = { 64, 1024 };
+  size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+  std::printf("threads,callbacks,grain,ns_per_invoke,speedup\n");
+  for (size_t count : counts)
+  {
+    std::vector<Agent> agents(count);
+    Event<void(float), false> event;
+    for (Agent &agent : agents)
+      event.Hook(agent, &Agent::Tick);
+
+    int repeats = int(std::max<size_t>(1, 10000000 / count));
+    for (size_t grain : grains)
+    {
+      event.SetParallelGrain(grain);
+      double single = 0;
+      for (size_t threads = 1; threads <= maxThreads; threads *= 2)
+      {
+        EventThreadPool pool(threads);
+        double ns = Measure(event, pool, repeats);
+        if (threads == 1) single = ns;
+        std::printf("%zu,%zu,%zu,%.0f,%.2f\n", threads, count, grain, ns, single / ns);
+      }
+    }
+  }
+  return 0;
+}
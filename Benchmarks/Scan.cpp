@@ -0,0 +1,74 @@
+/*!
+ * \file Scan.cpp
+ * \brief
+ *      Times each EventScan kernel against the scalar one on call list flags of 1K to 1M calls.
+ *      "scan" searches flags with nothing removed, the prefix Event::Compact skips over.
+ *      "runs" walks the runs of live and removed calls with one removed call in every 64,
+ *      the way Event::Compact does.
+ *      Prints comma separated results: benchmark, kernel, size, nanoseconds per flag, speedup
+ *
+ *      Built by the ScanBenchmark target, or g++ -std=c++17 -O2 -I.. Scan.cpp
+ */
+#include "Events.hpp"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+static constexpr uint8_t Removed = 1;
+static constexpr size_t FlagsPerCase = 1 << 28;
+
+static size_t Walk(EventScan::Kernel kernel, const std::vector<uint8_t> &flags)
+{
+  size_t runs = 0;
+  size_t index = kernel(flags.data(), 0, flags.size(), Removed, Removed);
+  while (index < flags.size())
+  {
+    index = kernel(flags.data(), index, flags.size(), Removed, 0);
+    index = kernel(flags.data(), index, flags.size(), Removed, Removed);
+    ++runs;
+  }
+  return runs;
+}
+
+static double Measure(EventScan::Kernel kernel, const std::vector<uint8_t> &flags, bool runs)
+{
+  size_t repeats = std::max<size_t>(1, FlagsPerCase / flags.size());
+  size_t sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < repeats; ++i)
+    sink += runs ? Walk(kernel, flags) : kernel(flags.data(), 0, flags.size(), Removed, Removed);
+  auto end = std::chrono::steady_clock::now();
+  if (sink == 1) std::printf("#\n");
+  return std::chrono::duration<double, std::nano>(end - start).count() / double(repeats * flags.size());
+}
+
+int main()
+{
+  std::vector<std::pair<const char*, EventScan::Kernel>> kernels = { { "scalar", &EventScan::FindScalar } };
+#ifdef EVENT_SIMD_X86
+  kernels.emplace_back("sse2", &EventScan::FindSse2);
+  if (std::string(EventScan::KernelName()) == "avx2")
+    kernels.emplace_back("avx2", &EventScan::FindAvx2);
+#endif
+
+  std::printf("benchmark,kernel,size,ns_per_flag,speedup\n");
+  for (bool runs : { false, true })
+    for (size_t size = 1000; size <= 1000000; size *= 10)
+    {
+      std::vector<uint8_t> flags(size, 0);
+      if (runs)
+        for (size_t i = 63; i < size; i += 64)
+          flags[i] = Removed;
+
+      double scalar = 0;
+      for (const auto &kernel : kernels)
+      {
+        double ns = Measure(kernel.second, flags, runs);
+        if (kernel.second == &EventScan::FindScalar) scalar = ns;
+        std::printf("%s,%s,%zu,%.4f,%.2f\n", runs ? "runs" : "scan", kernel.first, size, ns, scalar / ns);
+      }
+    }
+  return 0;
+}
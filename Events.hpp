@@ -22,13 +22,38 @@
 #define EVENTS_HPP
 #pragma once
 
-#include <unordered_set> // unordered_set
-#include <functional>    // function
+#include <type_traits>   // conditional_t, is_scalar_v
+#include <functional>    // function, invoke
+#include <algorithm>     // find
+#include <atomic>        // atomic
+#include <memory>        // unique_ptr
+#include <thread>        // this_thread::yield
+#include <limits>        // numeric_limits
+#include <mutex>         // mutex, unique_lock
+#include <condition_variable> // condition_variable
+#include <deque>         // deque
 #include <cassert>       // assert
 #include <cstdint>       // uint64_t
+#include <cstring>       // memcpy
+#include <utility>       // forward, move
 #include <vector>        // vector
+#include <tuple>         // tuple, apply
+#include <iterator>      // data, size
+#include <unordered_map> // unordered_map
+#include <new>           // launder, align_val_t
+#include <cstddef>       // max_align_t
 #include <map>           // map
 
+/*!
+ * \brief
+ *      Defined when the compiler supports C++20 coroutines, enabling Event::Next
+ */
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>     // coroutine_handle
+#include <optional>      // optional
+#define EVENT_COROUTINES
+#endif
+
 //! For variadic template expansion
 #define PACK_EXPAND(function, ...) ((void)function(__VA_ARGS__), ...);
 
@@ -36,28 +61,34 @@
  * \brief
  *      Handle to a function within the event call list
  *      Layout of EVENT_HANDLE memory:
- *                                              |    32bits    |       32bits     |
- *      if non-member function                = | 0            | &function        |
- *      if non-static member function         = | &class       | &member_function |
- *      if non-member function cluster        = | unique val   | &function        |
- *      if non-static member function cluster = | unique val   | &member_function |
+ *                              | 1bit | 31bits     | 32bits     |
+ *      if function or method = | 0    | generation | slot index |
+ *      if cluster            = | 1    | 0          | cluster id |
+ *      The slot index locates the call in the event's slot map, the generation is bumped each
+ *      time the slot is freed so handles of unhooked functions are rejected
  */
 using EVENT_HANDLE = uint64_t;
 
-// ! Mask for getting the cluster
-#define EVENT_CLUSTER_MASK 0b11111111111111111111111111111111'00000000000000000000000000000000
+//! Mask for getting the cluster flag
+#define EVENT_CLUSTER_MASK 0b10000000000000000000000000000000'00000000000000000000000000000000
+
+//! Mask for getting the generation
+#define EVENT_GENERATION_MASK 0b01111111111111111111111111111111'00000000000000000000000000000000
 
 //! Mask for getting the id
 #define EVENT_ID_MASK 0b00000000000000000000000000000000'11111111111111111111111111111111
 
-//! Gets the cluster from a handle
+//! Gets the cluster flag from a handle, non-zero if the handle belongs to a cluster
 #define GET_CLUSTER(handle) (EVENT_HANDLE(handle) & EVENT_CLUSTER_MASK)
 
+//! Gets the generation from a handle
+#define GET_GENERATION(handle) ((EVENT_HANDLE(handle) & EVENT_GENERATION_MASK) >> sizeof(uint32_t) * 8)
+
 //! Get the id from the handle
 #define GET_ID(handle) (EVENT_HANDLE(handle) & EVENT_ID_MASK)
 
-//! Constructs a handle with the last 4 bytes has the cluster and the first 4 be the ID
-#define GET_HANDLE(cluster, id) ((EVENT_HANDLE(cluster) << sizeof(uint32_t) * 8) | GET_ID(id))
+//! Constructs a handle with the last 4 bytes has the generation and the first 4 be the ID
+#define GET_HANDLE(generation, id) ((EVENT_HANDLE(generation) << sizeof(uint32_t) * 8) | GET_ID(id))
 
 //! For type checking with a cleaner syntax
 #define VERIFY_TYPE noexcept
@@ -85,756 +116,6158 @@ using EVENT_HANDLE = uint64_t;
       PERMUTE_PMF_CV(MACRO); \
       PERMUTE_PMF_CV(MACRO##_ELLIPSIS)
 
+#ifdef EVENT_PROFILE
+#include <chrono>        // steady_clock
+
 /*!
  * \brief
- *      Callback wrapper
+ *      Profiles every Nth invoke of each event, 1 profiles them all
  */
-template<typename Signature>
-struct Call
+#ifndef EVENT_PROFILE_SAMPLING
+#define EVENT_PROFILE_SAMPLING 1
+#endif
+
+/*!
+ * \brief
+ *      Timings of one callback, recorded by Event::Invoke when EVENT_PROFILE is defined
+ */
+struct EventProfile
+{
+  static constexpr size_t Buckets = 32; //!< Histogram buckets, bucket i holds calls of [2^i, 2^(i + 1)) nanoseconds
+
+  uint64_t count = 0;                   //!< Profiled calls
+  uint64_t totalNs = 0;                 //!< Nanoseconds spent in the profiled calls
+  uint64_t maxNs = 0;                   //!< Longest profiled call in nanoseconds
+  uint64_t histogram[Buckets] = {};     //!< Profiled calls by log2 of their nanoseconds, the last bucket holds the rest
+
+  /*!
+   * \brief
+   *      Adds a call to the profile
+   *
+   * \param ns
+   *      Nanoseconds the call took
+   */
+  void Record(uint64_t ns)
+  {
+    ++count;
+    totalNs += ns;
+    maxNs = std::max(maxNs, ns);
+
+    size_t bucket = 0;
+    while ((ns >>= 1) && bucket < Buckets - 1)
+      ++bucket;
+    ++histogram[bucket];
+  }
+};
+#endif
+
+/*!
+ * \brief
+ *      Gives each thread a cache of blocks in front of the default EventPool, 0 to disable
+ */
+#ifndef EVENT_POOL_THREAD_CACHE
+#define EVENT_POOL_THREAD_CACHE 1
+#endif
+
+/*!
+ * \brief
+ *      Counters of an EventPool
+ */
+struct EventPoolStats
+{
+  size_t chunks = 0;          //!< Chunks taken from the system
+  size_t reservedBytes = 0;   //!< Bytes of the chunks
+  size_t largeAllocations = 0; //!< Requests too large for a size class, passed to the system
+};
+
+/*!
+ * \brief
+ *      Allocator handing out blocks of a few size classes from free lists carved out of
+ *      large chunks. Freed blocks go back to their list and are never returned to the
+ *      system until the pool is destroyed, so hooking and unhooking reach a steady state
+ *      without calling malloc. Requests larger than the biggest class go to the system
+ */
+class EventPool
 {
+  public:
+    static constexpr size_t MinBlock = 16;         //!< Smallest size class, also the block alignment
+    static constexpr size_t ClassCount = 7;        //!< Size classes 16, 32, 64, ... 1024
+    static constexpr size_t MaxBlock = MinBlock << (ClassCount - 1); //!< Largest size class
+    static constexpr size_t ChunkSize = 64 * 1024; //!< Bytes taken from the system at once
+
     /*!
      * \brief
-     *      Default Constructor
+     *      Default Constructor, an arena for one or more events
      */
-    Call() : function([](){}), handle(EVENT_HANDLE(0))
-    {}
+    EventPool() = default;
+
+    EventPool(const EventPool&) = delete;
+    EventPool& operator=(const EventPool&) = delete;
 
     /*!
      * \brief
-     *      Constructor for non-member function
-     *
-     * \tparam F
-     *      Type of function
-     *
-     * \param func_ptr
-     *      Pointer to function to hook
-     *
-     * \param handle
-     *      Handle corresponding to the function 'func_ptr'
+     *      Destructor, returns every chunk to the system
+     *      NOTE: Everything allocated from the pool must be freed first
      */
-    template<typename Fn>
-    Call(Fn func_ptr, EVENT_HANDLE handle) : function(func_ptr), handle(handle)
-    {}
+    ~EventPool()
+    {
+      for (void *chunk : chunks_)
+        ::operator delete(chunk);
+    }
 
     /*!
      * \brief
-     *      Constructor for non-static member function
-     *
-     * \tparam C
-     *      Type of class
-     *
-     * \tparam F
-     *      Type of function
-     *
-     * \param class_ptr
-     *      Pointer to class
-     *
-     * \param func_ptr
-     *      Pointer to member function contained within class C
+     *      Gets the pool shared by every EventPoolAllocator constructed without a pool and by
+     *      Delegates too large to store in place. Never destroyed, so blocks may be freed
+     *      during static destruction
      *
-     * \param handle
-     *      Handle corresponding to member function
+     * \return
+     *      Returns the default pool
      */
-    template<typename C, typename Fn>
-    Call(C class_ptr, Fn func_ptr, EVENT_HANDLE handle) : function(GetMethod(class_ptr, func_ptr)), handle(handle)
-    {}
+    static EventPool& Default()
+    {
+      static EventPool *pool = new EventPool(EVENT_POOL_THREAD_CACHE != 0);
+      return *pool;
+    }
 
     /*!
      * \brief
-     *      Assignment operator that checks if the handles are the same
+     *      Allocates a block
      *
-     * \param other
-     *      Other call to check the handle of
+     * \param bytes
+     *      Size of the block
+     *
+     * \param alignment
+     *      Alignment of the block
      *
      * \return
-     *      Returns true if the handles are the same
+     *      Returns the block
      */
-    bool operator==(const Call<Signature>& other) const
+    void* Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
     {
-        return handle == other.handle;
+      if (bytes > MaxBlock || alignment > MinBlock)
+      {
+        large_.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(bytes, std::align_val_t(std::max(alignment, alignof(std::max_align_t))));
+      }
+
+      size_t sizeClass = SizeClass(bytes);
+      if (threadCache_)
+        if (ThreadCache *cache = Cache())
+          return cache->Allocate(*this, sizeClass);
+
+      std::lock_guard<std::mutex> lock(lock_);
+      return Pop(sizeClass);
     }
 
     /*!
      * \brief
-     *      Assignment operator that checks if the handles are the same
+     *      Frees a block
      *
-     * \param handle
-     *      Handle to compare with this handle
+     * \param block
+     *      Block to free, allocated from this pool
      *
-     * \return
-     *      Returns true if the handles are the same
+     * \param bytes
+     *      Size the block was allocated with
+     *
+     * \param alignment
+     *      Alignment the block was allocated with
      */
-    bool operator==(EVENT_HANDLE eventHandle) const
+    void Deallocate(void *block, size_t bytes, size_t alignment = alignof(std::max_align_t)) noexcept
     {
-        return handle == eventHandle;
+      if (!block) return;
+      if (bytes > MaxBlock || alignment > MinBlock)
+      {
+        ::operator delete(block, std::align_val_t(std::max(alignment, alignof(std::max_align_t))));
+        return;
+      }
+
+      size_t sizeClass = SizeClass(bytes);
+      if (threadCache_)
+        if (ThreadCache *cache = Cache())
+          return cache->Deallocate(*this, sizeClass, static_cast<Block*>(block));
+
+      std::lock_guard<std::mutex> lock(lock_);
+      Push(sizeClass, static_cast<Block*>(block));
     }
 
     /*!
      * \brief
-     *      Implicit conversion operator
+     *      Getter for the counters of the pool
      *
      * \return
-     *      Returns handle of call
+     *      Returns the counters
      */
-    explicit operator EVENT_HANDLE()
+    [[nodiscard]] EventPoolStats Stats() const
     {
-        return handle;
+      std::lock_guard<std::mutex> lock(lock_);
+      EventPoolStats stats;
+      stats.chunks = chunks_.size();
+      stats.reservedBytes = chunks_.size() * ChunkSize;
+      stats.largeAllocations = large_.load(std::memory_order_relaxed);
+      return stats;
     }
 
+  private:
+    //! Free block, linked through its first bytes
+    struct Block
+    {
+      Block *next; //!< Next free block of the same size class
+    };
+
     /*!
      * \brief
-     *      Overload for all non-ellipsis member functions
-     *
+     *      Blocks a thread keeps for the default pool, taken from and given back to it in batches
      */
-#define DEF_GET_METHOD(CV_REF_NOEXCEPT_OPT) \
-        template<typename C, typename R, typename ...Args> \
-        auto GetMethod(C *class_ptr, R(C::*func_ptr)(Args...) CV_REF_NOEXCEPT_OPT) \
-        { \
-          return [class_ptr, func_ptr] (Args... args) mutable { (void)(std::mem_fn(func_ptr)(class_ptr, args...)); }; \
+    struct ThreadCache
+    {
+      static constexpr size_t Batch = 32; //!< Blocks moved between the cache and the pool at once
+
+      Block *free[ClassCount] = {};  //!< Free blocks of each size class
+      size_t count[ClassCount] = {}; //!< Number of free blocks of each size class
+      EventPool *pool = nullptr;     //!< Pool the blocks belong to
+
+      /*!
+       * \brief
+       *      Destructor, gives every block back to the pool when the thread exits. Blocks freed
+       *      after that, such as by static events destroyed after the main thread's cache, go
+       *      straight to the pool
+       */
+      ~ThreadCache()
+      {
+        cacheDestroyed_ = true;
+        if (!pool) return;
+        std::lock_guard<std::mutex> lock(pool->lock_);
+        for (size_t sizeClass = 0; sizeClass < ClassCount; ++sizeClass)
+          while (free[sizeClass])
+          {
+            Block *block = free[sizeClass];
+            free[sizeClass] = block->next;
+            pool->Push(sizeClass, block);
+          }
+      }
+
+      /*!
+       * \brief
+       *      Takes a block, refilling the cache from the pool when empty
+       */
+      void* Allocate(EventPool &owner, size_t sizeClass)
+      {
+        pool = &owner;
+        if (!free[sizeClass])
+        {
+          std::lock_guard<std::mutex> lock(owner.lock_);
+          for (size_t i = 0; i < Batch; ++i)
+          {
+            Block *block = static_cast<Block*>(owner.Pop(sizeClass));
+            block->next = free[sizeClass];
+            free[sizeClass] = block;
+          }
+          count[sizeClass] += Batch;
+        }
+
+        Block *block = free[sizeClass];
+        free[sizeClass] = block->next;
+        --count[sizeClass];
+        return block;
+      }
+
+      /*!
+       * \brief
+       *      Keeps a block, giving a batch back to the pool when the cache holds too many
+       */
+      void Deallocate(EventPool &owner, size_t sizeClass, Block *block) noexcept
+      {
+        pool = &owner;
+        block->next = free[sizeClass];
+        free[sizeClass] = block;
+        if (++count[sizeClass] <= Batch * 2) return;
+
+        std::lock_guard<std::mutex> lock(owner.lock_);
+        for (size_t i = 0; i < Batch; ++i)
+        {
+          Block *give = free[sizeClass];
+          free[sizeClass] = give->next;
+          owner.Push(sizeClass, give);
         }
+        count[sizeClass] -= Batch;
+      }
+    };
+
+    mutable std::mutex lock_;            //!< Guards the free lists and chunks
+    Block *free_[ClassCount] = {};       //!< Free blocks of each size class
+    std::vector<void*> chunks_;          //!< Chunks taken from the system
+    unsigned char *cursor_ = nullptr;    //!< Next unused byte of the newest chunk
+    unsigned char *end_ = nullptr;       //!< End of the newest chunk
+    std::atomic<size_t> large_{0};       //!< Requests passed to the system
+    bool threadCache_ = false;           //!< Allocates through thread caches, only the default pool
+
+    //! Set once the calling thread's cache is destroyed, trivially destructible so it outlives it
+    static inline thread_local bool cacheDestroyed_ = false;
 
     /*!
      * \brief
-     *      Overload for all ellipsis member functions
+     *      Constructor for the default pool
+     *
+     * \param threadCache
+     *      True to allocate through thread caches
      */
-#define DEF_GET_METHOD_ELLIPSIS(CV_REF_NOEXCEPT_OPT) \
-        template<typename C, typename R, typename ...Args> \
-        auto GetMethod(C *class_ptr, R(C::*func_ptr)(Args..., ...) CV_REF_NOEXCEPT_OPT) \
-        { \
-          return [class_ptr, func_ptr](Args... args) mutable { (void)(std::mem_fn(func_ptr)(class_ptr, args...)); }; \
-        }
+    explicit EventPool(bool threadCache) : threadCache_(threadCache)
+    {}
 
     /*!
      * \brief
-     *      Generates all overloaded member functions for GetMethod
-     *
-     * \tparam C
-     *      Type of class
-     *
-     * \tparam R
-     *      Return type
-     *
-     * \tparam Args
-     *      Argument list
-     *
-     * \param class_ptr
-     *      Pointer to class
-     *
-     * \param func_ptr
-     *      Pointer to non-static member function contained within class C
+     *      Gets the calling thread's cache of the default pool
      *
      * \return
-     *      Returns a lambda that when called, calls the non-static member function
-     *      'func_ptr' contained within class 'class_ptr'
+     *      Returns the cache, or nullptr once the thread's cache has been destroyed
      */
-    PERMUTE_PMF(DEF_GET_METHOD);
+    static ThreadCache* Cache()
+    {
+      if (cacheDestroyed_) return nullptr;
+      thread_local ThreadCache cache;
+      return &cache;
+    }
+
+    /*!
+     * \brief
+     *      Gets the size class of a block size
+     */
+    static size_t SizeClass(size_t bytes)
+    {
+      size_t sizeClass = 0;
+      while ((MinBlock << sizeClass) < bytes)
+        ++sizeClass;
+      return sizeClass;
+    }
+
+    /*!
+     * \brief
+     *      Takes a free block of a size class, carving a new one from the chunk when none are free.
+     *      Called with lock_ held
+     */
+    void* Pop(size_t sizeClass)
+    {
+      if (Block *block = free_[sizeClass])
+      {
+        free_[sizeClass] = block->next;
+        return block;
+      }
+
+      size_t bytes = MinBlock << sizeClass;
+      if (size_t(end_ - cursor_) < bytes)
+      {
+        chunks_.reserve(chunks_.size() + 1);
+        cursor_ = static_cast<unsigned char*>(::operator new(ChunkSize));
+        end_ = cursor_ + ChunkSize;
+        chunks_.push_back(cursor_);
+      }
+
+      void *block = cursor_;
+      cursor_ += bytes;
+      return block;
+    }
 
-    std::function<Signature> function; //!< Function to call
-    EVENT_HANDLE handle;                //!< Handle corresponding to the function
+    /*!
+     * \brief
+     *      Returns a block to the free list of its size class. Called with lock_ held
+     */
+    void Push(size_t sizeClass, Block *block) noexcept
+    {
+      block->next = free_[sizeClass];
+      free_[sizeClass] = block;
+    }
 };
 
 /*!
  * \brief
- *      Templated event system that holds clients callbacks to be
- *      invoked on elsewhere
- *
- * \tparam FunctionSignature
- *      Function signature of the callbacks to hold
- *      NOTE: All callbacks must be of this type
- *
- * \tparam KeepOrder
- *      Tells the system to invoke callbacks in the same order as they
- *      were hooked.
+ *      Standard allocator drawing from an EventPool, for the Allocator of an Event.
+ *      Default constructed instances share EventPool::Default, pass a pool to give one
+ *      or more events their own arena
  *
- * \tparam Allocator
- *      Allocator for the call list. Must take struct 'Call'
+ * \tparam T
+ *      Type allocated
  */
-template<typename FunctionSignature, bool KeepOrder = true, typename Allocator = std::allocator<Call<FunctionSignature>>>
-class Event
+template<typename T>
+class EventPoolAllocator
 {
+    template<typename> friend class EventPoolAllocator;
+
+  public:
+    using value_type = T; //!< Type allocated
+
     /*!
      * \brief
-     *      Assures that all functions in list Fs are non-member functions of a class
-     *
-     * \tparam Fs
-     *      List of function types
-     *
-     * \return
-     *      Returns true if all functions are non-member functions of a class
-     *      else static assert
+     *      Default Constructor, allocates from the default pool
      */
-    template<typename ...Fns>
-    static constexpr bool class_member_exclusion()
-    {
-      static_assert(sizeof ...(Fns) > 0, "Calling variadic function with no parameters");
-      static_assert(!(... || std::is_member_function_pointer_v<Fns>), "A callback in variadic list Fs... is a class member");
-      return true;
-    }
+    EventPoolAllocator() noexcept : pool_(&EventPool::Default())
+    {}
 
     /*!
      * \brief
-     *      Used to check if the event can be invoked by the arguments passed in
+     *      Constructor
      *
-     * \tparam Args
-     *      List of type of arguments attempted to invoke the event with
+     * \param pool
+     *      Pool to allocate from, must outlive every container using it
+     */
+    explicit EventPoolAllocator(EventPool &pool) noexcept : pool_(&pool)
+    {}
+
+    /*!
+     * \brief
+     *      Rebinding constructor
      *
-     * \return
-     *      Returns true if the event can be invoked, else static assert
+     * \param other
+     *      Allocator of another type sharing the pool
      */
-    template<typename ...Args>
-    static constexpr bool invocable()
+    template<typename U>
+    EventPoolAllocator(const EventPoolAllocator<U> &other) noexcept : pool_(other.pool_)
+    {}
+
+    /*!
+     * \brief
+     *      Allocates room for n objects
+     */
+    T* allocate(size_t n)
     {
-      static_assert(std::is_invocable_v<_Signature , Args...>, "Attempting to invoke event with differing arguments then the event function signature");
-      return true;
+      if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+        throw std::bad_array_new_length();
+      return static_cast<T*>(pool_->Allocate(n * sizeof(T), alignof(T)));
     }
 
     /*!
      * \brief
-     *      Assures that a type is not contained within a variadic list
-     *
-     * \tparam Invalid_Type
-     *      Invalid type that list Types should not contain
-     *
-     * \tparam Types
-     *      List of types to check
-     *
-     * \return
-     *      Returns true if the type is not within the list, else static assert
+     *      Frees room for n objects
      */
-    template<typename Invalid_Type, typename ...Types>
-    static constexpr bool type_exclusion()
+    void deallocate(T *block, size_t n) noexcept
     {
-      static_assert(sizeof ...(Types) > 0, "Calling variadic function with no parameters");
-      static_assert(!(... || std::is_same_v<Invalid_Type, Types>), "Invalid Type contained in Types variadic list");
-      return true;
+      pool_->Deallocate(block, n * sizeof(T), alignof(T));
     }
 
     /*!
      * \brief
-     *      Assures that all functions in variadic Fs list belong to class C
-     *
-     * \tparam C
-     *      Type of class all functions Fs must be apart of
+     *      Getter for the pool
+     */
+    [[nodiscard]] EventPool& Pool() const noexcept
+    {
+      return *pool_;
+    }
+
+    //! Allocators are equal if they share a pool
+    template<typename U>
+    bool operator==(const EventPoolAllocator<U> &other) const noexcept
+    {
+      return pool_ == other.pool_;
+    }
+
+    //! Allocators are equal if they share a pool
+    template<typename U>
+    bool operator!=(const EventPoolAllocator<U> &other) const noexcept
+    {
+      return pool_ != other.pool_;
+    }
+
+  private:
+    EventPool *pool_; //!< Pool allocated from
+};
+
+/*!
+ * \brief
+ *      Define to leave EventScan on its scalar kernels
+ */
+#if !defined(EVENT_NO_SIMD) && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define EVENT_SIMD_X86
+#include <immintrin.h>   // _mm_cmpeq_epi8, _mm256_cmpeq_epi8
+#endif
+
+/*!
+ * \brief
+ *      Kernels searching the flag bytes of a call list, used by Event to skip over runs of
+ *      live or removed calls when compacting. On x86-64 with GCC or Clang the search compares
+ *      16 flags per instruction with SSE2, or 32 with AVX2 when the CPU has it, picked once
+ *      at runtime. Everywhere else, or with EVENT_NO_SIMD defined, it compares one at a time
+ */
+class EventScan
+{
+  public:
+    //! Signature of a kernel, see EventScan::Find
+    using Kernel = size_t(*)(const uint8_t *flags, size_t first, size_t last, uint8_t mask, uint8_t value);
+
+    /*!
+     * \brief
+     *      Finds the first flag in a range with the masked bits equal to a value,
+     *      using the fastest kernel the CPU supports
      *
-     * \tparam Fs
-     *      List of function types
+     * \param flags
+     *      Flags to search
+     *
+     * \param first
+     *      Index to start at
+     *
+     * \param last
+     *      Index to stop at
+     *
+     * \param mask
+     *      Bits of each flag to compare
+     *
+     * \param value
+     *      Value the masked bits must equal
      *
      * \return
-     *      Returns true if all functions in list Fs belong to class C
-     *      else static assert
+     *      Returns the index of the flag, last if there is none
      */
-    template<typename C, typename ...Fns>
-    static constexpr bool class_member_inclusion()
+    static size_t Find(const uint8_t *flags, size_t first, size_t last, uint8_t mask, uint8_t value)
     {
-      static_assert(std::is_class_v<C>, "Provided class pointer is not a class");
-      static_assert(sizeof ...(Fns) > 0, "Calling variadic function with no parameters");
-      static_assert((... && is_member_function_of<C, Fns>::value), "A callback in variadic list Fs... is not a non-static member of class C");
-      return true;
+      static const Kernel kernel = Select();
+      return kernel(flags, first, last, mask, value);
+    }
+
+    //! Name of the kernel EventScan::Find uses
+    static const char* KernelName()
+    {
+      Kernel kernel = Select();
+#ifdef EVENT_SIMD_X86
+      if (kernel == &FindAvx2) return "avx2";
+      if (kernel == &FindSse2) return "sse2";
+#endif
+      return kernel == &FindScalar ? "scalar" : "unknown";
+    }
+
+    //! Kernel comparing one flag at a time, see EventScan::Find
+    static size_t FindScalar(const uint8_t *flags, size_t first, size_t last, uint8_t mask, uint8_t value)
+    {
+      while (first < last && (flags[first] & mask) != value)
+        ++first;
+      return first;
+    }
+
+#ifdef EVENT_SIMD_X86
+    //! Kernel comparing 16 flags at a time, see EventScan::Find
+    static size_t FindSse2(const uint8_t *flags, size_t first, size_t last, uint8_t mask, uint8_t value)
+    {
+      const __m128i masks = _mm_set1_epi8(char(mask));
+      const __m128i values = _mm_set1_epi8(char(value));
+      for (; first + 16 <= last; first += 16)
+      {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(flags + first));
+        unsigned matches = unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(block, masks), values)));
+        if (matches) return first + size_t(__builtin_ctz(matches));
+      }
+      return FindScalar(flags, first, last, mask, value);
+    }
+
+    //! Kernel comparing 32 flags at a time, see EventScan::Find
+    __attribute__((target("avx2")))
+    static size_t FindAvx2(const uint8_t *flags, size_t first, size_t last, uint8_t mask, uint8_t value)
+    {
+      const __m256i masks = _mm256_set1_epi8(char(mask));
+      const __m256i values = _mm256_set1_epi8(char(value));
+      for (; first + 32 <= last; first += 32)
+      {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(flags + first));
+        unsigned matches = unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(block, masks), values)));
+        if (matches) return first + size_t(__builtin_ctz(matches));
+      }
+      return FindScalar(flags, first, last, mask, value);
     }
+#endif
 
+  private:
     /*!
      * \brief
-     *      Assures that all functions in list Fs are callable by this event
-     *
-     * \tparam Fs
-     *      List of functions to assure are compatible with this event function signature
+     *      Picks the kernel for the CPU running the program
      *
      * \return
-     *      Returns true if the list Fs is compatible with this event, else static assert
+     *      Returns the kernel
      */
-    template<typename ...Fns>
-    static constexpr bool is_same_arg_list()
+    static Kernel Select()
     {
-      static_assert((... && parameter_equivalents<_Signature , Fns>::value), "Attempted to hook a callback that does not have the same parameter list as the event");
-      return true;
+#ifdef EVENT_SIMD_X86
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2") ? &FindAvx2 : &FindSse2;
+#else
+      return &FindScalar;
+#endif
     }
+};
+
+/*!
+ * \brief
+ *      Bytes a Delegate stores in place before falling back to EventPool::Default.
+ *      Defaults to room for a class pointer plus a pointer to member function
+ */
+#ifndef EVENT_DELEGATE_INLINE_SIZE
+#define EVENT_DELEGATE_INLINE_SIZE (sizeof(void*) * 3)
+#endif
+
+/*!
+ * \brief
+ *      Fixed size, type erased callable used by the call list in place of std::function
+ *
+ * \tparam Signature
+ *      Function signature of the callable
+ *
+ * \tparam InlineSize
+ *      Bytes reserved in place for the callable. Larger callables are heap allocated
+ */
+template<typename Signature, std::size_t InlineSize = EVENT_DELEGATE_INLINE_SIZE>
+class Delegate;
+
+/*!
+ * \brief
+ *      Delegate specialization splitting the signature into its return and argument types
+ *
+ * \tparam R
+ *      Return type
+ *
+ * \tparam Args
+ *      Argument list
+ *
+ * \tparam InlineSize
+ *      Bytes reserved in place for the callable
+ */
+template<typename R, typename ...Args, std::size_t InlineSize>
+class Delegate<R(Args...), InlineSize>
+{
+    //! Scalars and references pass through as is, everything else is forwarded by reference
+    template<typename T>
+    using Forward = std::conditional_t<std::is_scalar_v<T> || std::is_reference_v<T>, T, T&&>;
+
+    //! True if a callable of type Fn fits in the in place storage
+    template<typename Fn>
+    static constexpr bool stored_inline = sizeof(Fn) <= InlineSize && alignof(Fn) <= alignof(void*)
+                                          && std::is_nothrow_move_constructible_v<Fn>;
+
+    //! True if a callable of type Fn can be copied and discarded without calling into it
+    template<typename Fn>
+    static constexpr bool trivial = stored_inline<Fn> && std::is_trivially_copyable_v<Fn>;
+
+    //! Operations the manager performs on the stored callable
+    enum class Operation { Copy, Move, Destroy };
+
+    using Invoker = R(*)(void*, Forward<Args>...);                      //!< Thunk calling the stored callable
+    using Manager = void(*)(Operation, Delegate*, const Delegate*); //!< Copies, moves and destroys the stored callable
 
   public:
-    using _Signature = FunctionSignature;       //!< Function Signature
-    using _Allocator = Allocator;               //!< Event allocator
-    using _CallType  = Call<FunctionSignature>; //!< Type of the call wrapper
-    static constexpr bool Ordered = KeepOrder;  //!< State of ordering
+    static constexpr std::size_t Capacity = InlineSize; //!< Bytes reserved in place
 
     /*!
      * \brief
-     *      Hooks a non-member function to the event system provided that the type of 'func_ptr'
-     *      matches that of 'FUNCTION_SIGNATURE'
+     *      Default Constructor, holds nothing
+     */
+    Delegate() noexcept = default;
+
+    /*!
+     * \brief
+     *      Constructor for any callable matching the signature
      *
-     * \tparam F
-     *      Type of function
+     * \tparam Fn
+     *      Type of callable
      *
-     * \param func_ptr
-     *      Pointer to non-member function to be hooked
+     * \param fn
+     *      Callable to store, placed in line when it fits
+     */
+    template<typename Fn, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Fn>, Delegate>>>
+    Delegate(Fn &&fn)
+    {
+      Store<std::decay_t<Fn>>(std::forward<Fn>(fn));
+    }
+
+    /*!
+     * \brief
+     *      Copy Constructor
      *
-     * \return
-     *      Returns a handle corresponding to the hooked function.
-     *      NOTE: Must not be ignored when hooking lambdas, otherwise they become permanently hooked
+     * \param other
+     *      Delegate to copy the callable of
      */
-    template<typename Fn>
-    EVENT_HANDLE Hook(Fn &&func_ptr)
-    VERIFY_TYPE(class_member_exclusion<Fn>() && is_same_arg_list<Fn>())
+    Delegate(const Delegate &other)
     {
-      EVENT_HANDLE handle = GET_HANDLE(POINTER_INT_CAST(nullptr), POINTER_INT_CAST(&func_ptr));
-      callList_.emplace_back(Call<_Signature>(func_ptr, handle));
-      return handle;
+      CopyFrom(other);
     }
 
     /*!
      * \brief
-     *      Hooks a non-static member function to the event system
+     *      Move Constructor
      *
-     * \tparam C
-     *      Type of user defined type
+     * \param other
+     *      Delegate to take the callable of, left empty
+     */
+    Delegate(Delegate &&other) noexcept
+    {
+      MoveFrom(other);
+    }
+
+    /*!
+     * \brief
+     *      Copy assignment operator
      *
-     * \tparam F
-     *      Type of function pointer
+     * \param other
+     *      Delegate to copy the callable of
      *
-     * \param class_ref
-     *      Reference to the class that has non-static member function 'func_ptr'
+     * \return
+     *      Returns this delegate
+     */
+    Delegate& operator=(const Delegate &other)
+    {
+      if (this != &other)
+      {
+        Reset();
+        CopyFrom(other);
+      }
+      return *this;
+    }
+
+    /*!
+     * \brief
+     *      Move assignment operator
      *
-     * \param func_ptr
-     *      Pointer to non-static member function to hook
+     * \param other
+     *      Delegate to take the callable of, left empty
      *
      * \return
-     *      Returns handle corresponding to non-static member function hooked
+     *      Returns this delegate
      */
-    template<typename C, typename Fn>
-    EVENT_HANDLE Hook(C &class_ref, Fn func_ptr)
-    VERIFY_TYPE(class_member_inclusion<C, Fn>() && is_same_arg_list<Fn>())
+    Delegate& operator=(Delegate &&other) noexcept
     {
-      EVENT_HANDLE handle = GET_HANDLE(POINTER_INT_CAST(&class_ref), POINTER_INT_CAST(func_ptr));
-      callList_.emplace_back(Call<_Signature>(&class_ref, func_ptr, handle));
-      return handle;
+      if (this != &other)
+      {
+        Reset();
+        MoveFrom(other);
+      }
+      return *this;
     }
 
     /*!
      * \brief
-     *      Hooks a cluster of non-member functions to the event system
+     *      Destructor
+     */
+    ~Delegate()
+    {
+      Reset();
+    }
+
+    /*!
+     * \brief
+     *      Calls the stored callable through a single thunk
      *
-     * \tparam Fs
-     *      List of non-member function types
+     * \param args
+     *      Arguments to pass to the callable
      *
-     * \param func_ptrs
-     *      List of pointers to non-member functions to be hooked
+     * \return
+     *      Returns the result of the callable, converted to R
+     */
+    R operator()(Args... args) const
+    {
+      assert(invoker_ && "ERROR : Calling an empty delegate");
+      return invoker_(storage_, std::forward<Args>(args)...);
+    }
+
+    /*!
+     * \brief
+     *      Checks if a callable is stored
      *
      * \return
-     *      Returns handle to corresponding to the cluster of non-member functions
+     *      Returns true if a callable is stored
      */
-    template<typename ...Fns>
-    [[nodiscard]] EVENT_HANDLE HookFunctionCluster(Fns&&... func_ptrs)
-    VERIFY_TYPE(class_member_exclusion<Fns...>() && type_exclusion<EVENT_HANDLE, Fns...>() && is_same_arg_list<Fns...>())
+    explicit operator bool() const noexcept
     {
-      PACK_EXPAND(callList_.emplace_back, Call<_Signature>(func_ptrs, GET_HANDLE(clusterHandle_ + 1, POINTER_INT_CAST(&func_ptrs))))
-      return GET_HANDLE(++clusterHandle_, POINTER_INT_CAST(nullptr));
+      return invoker_ != nullptr;
     }
 
     /*!
      * \brief
-     *      Hooks a cluster of non-static member functions to the event system
+     *      Gets the stored callable, named after std::function::target so either works as
+     *      the Function of an event
      *
-     * \tparam C
-     *      Type of user defined type
+     * \tparam Fn
+     *      Type of the callable
      *
-     * \tparam Fs
-     *      List of non-static member function types
+     * \return
+     *      Returns a pointer to the callable, or nullptr if it is not of type Fn
+     */
+    template<typename Fn>
+    const Fn* target() const noexcept
+    {
+      return invoker_ == &Invoke<Fn> ? Target<Fn>(storage_) : nullptr;
+    }
+
+    /*!
+     * \brief
+     *      Destroys the stored callable, leaving the delegate empty
+     */
+    void Reset() noexcept
+    {
+      if (manager_) manager_(Operation::Destroy, this, nullptr);
+      invoker_ = nullptr;
+      manager_ = nullptr;
+    }
+
+  private:
+    alignas(void*) mutable unsigned char storage_[InlineSize]; //!< In place callable or pointer to heap callable
+    Invoker invoker_ = nullptr;                                 //!< Thunk for the stored callable
+    Manager manager_ = nullptr;                                 //!< Null when the stored callable is trivial
+
+    /*!
+     * \brief
+     *      Gets the stored callable of type Fn
      *
-     * \param class_ref
-     *      Reference to the class that has non-static member functions 'func_ptrs'
+     * \param storage
+     *      Storage of a delegate holding a callable of type Fn
      *
-     * \param func_ptrs
-     *      List of pointers to non-static member functions to be hooked
+     * \return
+     *      Returns a pointer to the callable
+     */
+    template<typename Fn>
+    static Fn* Target(void *storage) noexcept
+    {
+      if constexpr (stored_inline<Fn>)
+        return std::launder(reinterpret_cast<Fn*>(storage));
+      else
+        return *std::launder(reinterpret_cast<Fn**>(storage));
+    }
+
+    /*!
+     * \brief
+     *      Constructs a callable too large to store in place in a block of the default pool
+     *
+     * \param fn
+     *      Callable to construct from
      *
      * \return
-     *      Returns handle to corresponding to the cluster of non-static member functions
+     *      Returns the callable
      */
-    template<typename C, typename ...Fns>
-    [[nodiscard]] EVENT_HANDLE HookMethodCluster(C &class_ref, Fns... func_ptrs)
-    VERIFY_TYPE(class_member_inclusion<C, Fns...>() && type_exclusion<EVENT_HANDLE, Fns...>() && is_same_arg_list<Fns...>())
+    template<typename Fn, typename F>
+    static Fn* New(F &&fn)
     {
-      PACK_EXPAND(callList_.emplace_back, Call<_Signature>(&class_ref, func_ptrs, GET_HANDLE(clusterHandle_ + 1, POINTER_INT_CAST(func_ptrs))))
-      return GET_HANDLE(++clusterHandle_, POINTER_INT_CAST(nullptr));
+      void *block = EventPool::Default().Allocate(sizeof(Fn), alignof(Fn));
+      try
+      {
+        return ::new (block) Fn(std::forward<F>(fn));
+      }
+      catch (...)
+      {
+        EventPool::Default().Deallocate(block, sizeof(Fn), alignof(Fn));
+        throw;
+      }
     }
 
     /*!
      * \brief
-     *      Invokes callbacks hooked to the event
-     *      NOTE: Hooking or Unhooking to the same event during the invoke process is undefined
-     *      NOTE: Thread safe
+     *      Places a callable in the storage and selects its thunk and manager
      *
-     * \tparam Args
-     *      Types of the parameters passed in
+     * \tparam Fn
+     *      Decayed type of the callable
      *
-     * \param args
-     *      Parameters to pass to each of the callback functions
-     *      NOTE: Must be the same arguments as the FUNCTION_SIGNATURE
+     * \param fn
+     *      Callable to store
      */
-    template<typename ...Args>
-    void Invoke(Args... args)
-    VERIFY_TYPE(invocable<Args...>())
+    template<typename Fn, typename F>
+    void Store(F &&fn)
     {
-      for (auto &call : callList_)
-        call.function(args...);
+      static_assert(std::is_copy_constructible_v<Fn>, "Delegate requires a copy constructible callable");
+      if constexpr (stored_inline<Fn>)
+        ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(fn));
+      else
+        ::new (static_cast<void*>(storage_)) Fn*(New<Fn>(std::forward<F>(fn)));
+
+      invoker_ = &Invoke<Fn>;
+      manager_ = trivial<Fn> ? nullptr : &Manage<Fn>;
     }
 
     /*!
      * \brief
-     *      Unhooks non-member function from event
+     *      Copies the callable of another delegate into this empty delegate
      *
-     * \tparam F
-     *      Type of function pointer
+     * \param other
+     *      Delegate to copy
+     */
+    void CopyFrom(const Delegate &other)
+    {
+      if (other.manager_)
+        other.manager_(Operation::Copy, this, &other);
+      else
+        std::memcpy(storage_, other.storage_, InlineSize);
+      invoker_ = other.invoker_;
+      manager_ = other.manager_;
+    }
+
+    /*!
+     * \brief
+     *      Takes the callable of another delegate into this empty delegate
      *
-     * \param func_ptr
-     *      Pointer to non-member function to unhook
+     * \param other
+     *      Delegate to move from, left empty
      */
-    template<typename Fn>
-    void Unhook(Fn func_ptr)
-    VERIFY_TYPE(class_member_exclusion<Fn>())
+    void MoveFrom(Delegate &other) noexcept
     {
-      RemoveCall(GET_HANDLE(POINTER_INT_CAST(nullptr), POINTER_INT_CAST(func_ptr)));
+      if (other.manager_)
+        other.manager_(Operation::Move, this, &other);
+      else
+        std::memcpy(storage_, other.storage_, InlineSize);
+      invoker_ = other.invoker_;
+      manager_ = other.manager_;
+      other.invoker_ = nullptr;
+      other.manager_ = nullptr;
     }
 
     /*!
      * \brief
-     *      Unhooks non-static member function from event
+     *      Thunk that calls a stored callable of type Fn
      *
-     * \tparam C
-     *      Type of user defined type
+     * \param storage
+     *      Storage of the delegate being called
      *
-     * \tparam F
-     *      Type of non-static member function
+     * \param args
+     *      Arguments to pass to the callable
      *
-     * \param class_ref
-     *      Reference to user defined type that contains the non-static member function 'func_ptr'
+     * \return
+     *      Returns the result of the callable, discarded if R is void
+     */
+    template<typename Fn>
+    static R Invoke(void *storage, Forward<Args>... args)
+    {
+      if constexpr (std::is_void_v<R>)
+        (void)std::invoke(*Target<Fn>(storage), std::forward<Forward<Args>>(args)...);
+      else
+        return std::invoke(*Target<Fn>(storage), std::forward<Forward<Args>>(args)...);
+    }
+
+    /*!
+     * \brief
+     *      Copies, moves or destroys a stored callable of type Fn
+     *
+     * \param operation
+     *      Operation to perform
+     *
+     * \param dst
+     *      Delegate receiving the callable, or the delegate to destroy
+     *
+     * \param src
+     *      Delegate the callable is copied or moved from
+     */
+    template<typename Fn>
+    static void Manage(Operation operation, Delegate *dst, const Delegate *src)
+    {
+      switch (operation)
+      {
+        case Operation::Copy:
+          if constexpr (stored_inline<Fn>)
+            ::new (static_cast<void*>(dst->storage_)) Fn(*Target<Fn>(src->storage_));
+          else
+            ::new (static_cast<void*>(dst->storage_)) Fn*(New<Fn>(*Target<Fn>(src->storage_)));
+          break;
+        case Operation::Move:
+          if constexpr (stored_inline<Fn>)
+          {
+            ::new (static_cast<void*>(dst->storage_)) Fn(std::move(*Target<Fn>(src->storage_)));
+            Target<Fn>(src->storage_)->~Fn();
+          }
+          else
+            std::memcpy(dst->storage_, src->storage_, sizeof(Fn*));
+          break;
+        case Operation::Destroy:
+          if constexpr (stored_inline<Fn>)
+            Target<Fn>(dst->storage_)->~Fn();
+          else
+          {
+            Fn *fn = Target<Fn>(dst->storage_);
+            fn->~Fn();
+            EventPool::Default().Deallocate(fn, sizeof(Fn), alignof(Fn));
+          }
+          break;
+      }
+    }
+};
+
+/*!
+ * \brief
+ *      Callback wrapper
+ *
+ * \tparam Signature
+ *      Function signature of the callback
+ *
+ * \tparam Function
+ *      Type erased callable holding the callback
+ */
+template<typename Signature, typename Function = Delegate<Signature>>
+struct Call
+{
+    /*!
+     * \brief
+     *      Default Constructor
+     */
+    Call() : function([](){}), handle(EVENT_HANDLE(0)), removed(false), batch(false), once(false), priority(0)
+    {}
+
+    /*!
+     * \brief
+     *      Constructor for non-member function
+     *
+     * \tparam F
+     *      Type of function
+     *
+     * \param func_ptr
+     *      Pointer to function to hook
+     *
+     * \param handle
+     *      Handle corresponding to the function 'func_ptr'
+     */
+    template<typename Fn>
+    Call(Fn func_ptr, EVENT_HANDLE handle) : function(func_ptr), handle(handle), removed(false), batch(false), once(false), priority(0)
+    {}
+
+    /*!
+     * \brief
+     *      Constructor for non-static member function
+     *
+     * \tparam C
+     *      Type of class
+     *
+     * \tparam F
+     *      Type of function
+     *
+     * \param class_ptr
+     *      Pointer to class
+     *
+     * \param func_ptr
+     *      Pointer to member function contained within class C
+     *
+     * \param handle
+     *      Handle corresponding to member function
+     */
+    template<typename C, typename Fn>
+    Call(C class_ptr, Fn func_ptr, EVENT_HANDLE handle) : function(GetMethod(class_ptr, func_ptr)), handle(handle), removed(false), batch(false), once(false), priority(0)
+    {}
+
+    /*!
+     * \brief
+     *      Assignment operator that checks if the handles are the same
+     *
+     * \param other
+     *      Other call to check the handle of
+     *
+     * \return
+     *      Returns true if the handles are the same
+     */
+    bool operator==(const Call& other) const
+    {
+        return handle == other.handle;
+    }
+
+    /*!
+     * \brief
+     *      Assignment operator that checks if the handles are the same
+     *
+     * \param handle
+     *      Handle to compare with this handle
+     *
+     * \return
+     *      Returns true if the handles are the same
+     */
+    bool operator==(EVENT_HANDLE eventHandle) const
+    {
+        return handle == eventHandle;
+    }
+
+    /*!
+     * \brief
+     *      Implicit conversion operator
+     *
+     * \return
+     *      Returns handle of call
+     */
+    explicit operator EVENT_HANDLE()
+    {
+        return handle;
+    }
+
+    /*!
+     * \brief
+     *      Overload for all non-ellipsis member functions
+     *
+     */
+#define DEF_GET_METHOD(CV_REF_NOEXCEPT_OPT) \
+        template<typename C, typename R, typename ...Args> \
+        auto GetMethod(C *class_ptr, R(C::*func_ptr)(Args...) CV_REF_NOEXCEPT_OPT) \
+        { \
+          return [class_ptr, func_ptr] (Args... args) -> R { return std::invoke(func_ptr, class_ptr, std::forward<Args>(args)...); }; \
+        }
+
+    /*!
+     * \brief
+     *      Overload for all ellipsis member functions
+     */
+#define DEF_GET_METHOD_ELLIPSIS(CV_REF_NOEXCEPT_OPT) \
+        template<typename C, typename R, typename ...Args> \
+        auto GetMethod(C *class_ptr, R(C::*func_ptr)(Args..., ...) CV_REF_NOEXCEPT_OPT) \
+        { \
+          return [class_ptr, func_ptr] (Args... args) -> R { return std::invoke(func_ptr, class_ptr, std::forward<Args>(args)...); }; \
+        }
+
+    /*!
+     * \brief
+     *      Generates all overloaded member functions for GetMethod
+     *
+     * \tparam C
+     *      Type of class
+     *
+     * \tparam R
+     *      Return type
+     *
+     * \tparam Args
+     *      Argument list
+     *
+     * \param class_ptr
+     *      Pointer to class
+     *
+     * \param func_ptr
+     *      Pointer to non-static member function contained within class C
+     *
+     * \return
+     *      Returns a lambda that when called, calls the non-static member function
+     *      'func_ptr' contained within class 'class_ptr'. The lambda holds only the two
+     *      pointers so it stays within a Delegate's in place storage
+     */
+    PERMUTE_PMF(DEF_GET_METHOD);
+
+    Function function;   //!< Function to call
+    EVENT_HANDLE handle; //!< Handle corresponding to the function
+    bool removed;        //!< Unhooked, skipped by invoke until the call list is compacted
+    bool batch;          //!< Hooked by HookBatch, takes a whole batch of payloads at once
+    bool once;           //!< Hooked by HookOnce, unhooked by the next invoke that reaches it
+    int32_t priority;    //!< Calls with a higher priority are invoked first
+};
+
+/*!
+ * \brief
+ *      Splits a function signature into the types the event stores and returns
+ */
+template<typename Signature>
+struct signature_traits;
+
+/*!
+ * \brief
+ *      Specialization for function signatures
+ *
+ * \tparam R
+ *      Return type
+ *
+ * \tparam Args
+ *      Argument list
+ */
+template<typename R, typename ...Args>
+struct signature_traits<R(Args...)>
+{
+  using Return  = R;                                 //!< Return type of the callbacks
+  using Payload = std::tuple<std::decay_t<Args>...>; //!< Arguments of one invoke, stored by value
+  using References = std::tuple<const std::decay_t<Args>&...>; //!< Arguments of one invoke, by const reference
+  static constexpr size_t Arity = sizeof...(Args);   //!< Number of arguments
+  //! True if every argument can be passed from a const payload, no non-const references
+  static constexpr bool ConstArguments = (std::is_convertible_v<const std::decay_t<Args>&, Args> && ...);
+
+  //! Callback taking a batch of payloads at once
+  using Batch = Delegate<void(const Payload*, size_t)>;
+
+  /*!
+   * \brief
+   *      Wraps a batch callback so single invokes reach it as a batch of one
+   */
+  struct BatchCall
+  {
+    /*!
+     * \brief
+     *      Calls the batch callback with the arguments of a single invoke
+     *
+     * \param args
+     *      Arguments of the invoke
+     */
+    void operator()(Args... args) const
+    {
+      Payload payload(std::forward<Args>(args)...);
+      batch(&payload, 1);
+    }
+
+    Batch batch; //!< Batch callback
+  };
+};
+
+/*!
+ * \brief
+ *      Subscription of an EventListener to an event, linked into both the listener's list
+ *      and the event's list so whichever is destroyed first can unlink it
+ */
+struct EventSubscription
+{
+  struct EventSubscriptions *owner;                                  //!< Subscriptions of the event
+  void (*unhook)(struct EventSubscriptions *owner, EVENT_HANDLE handle); //!< Unhooks a handle from the event
+  EVENT_HANDLE handle;                                               //!< Handle of the call
+  EventSubscription **listenerHead;                                  //!< Head of the listener's list
+  EventSubscription *listenerPrev;                                   //!< Previous subscription of the listener
+  EventSubscription *listenerNext;                                   //!< Next subscription of the listener
+  EventSubscription *eventPrev;                                      //!< Previous subscription to the event
+  EventSubscription *eventNext;                                      //!< Next subscription to the event
+};
+
+/*!
+ * \brief
+ *      Subscriptions of EventListeners to an event, a private base of Event. Costs a pointer
+ *      per event and nothing on invoke. Copies of an event start with no subscriptions, moves
+ *      take them along
+ */
+struct EventSubscriptions
+{
+  EventSubscription *firstSubscription = nullptr; //!< First subscription
+
+  EventSubscriptions() = default;
+
+  //! Copies start with no subscriptions, the listeners track the original event only
+  EventSubscriptions(const EventSubscriptions&) noexcept {}
+
+  //! Takes the subscriptions of another event
+  EventSubscriptions(EventSubscriptions &&other) noexcept
+  {
+    Take(other);
+  }
+
+  //! Drops the subscriptions to the calls being replaced
+  EventSubscriptions& operator=(const EventSubscriptions &other) noexcept
+  {
+    if (this != &other) Detach();
+    return *this;
+  }
+
+  //! Drops the subscriptions to the calls being replaced and takes those of another event
+  EventSubscriptions& operator=(EventSubscriptions &&other) noexcept
+  {
+    if (this != &other)
+    {
+      Detach();
+      Take(other);
+    }
+    return *this;
+  }
+
+  ~EventSubscriptions()
+  {
+    Detach();
+  }
+
+  /*!
+   * \brief
+   *      Unlinks every subscription from its listener and frees it, without unhooking anything
+   */
+  void Detach() noexcept
+  {
+    while (EventSubscription *subscription = firstSubscription)
+    {
+      firstSubscription = subscription->eventNext;
+      UnlinkListener(subscription);
+      Free(subscription);
+    }
+  }
+
+  //! Removes a subscription from its listener's list
+  static void UnlinkListener(EventSubscription *subscription) noexcept
+  {
+    if (subscription->listenerNext) subscription->listenerNext->listenerPrev = subscription->listenerPrev;
+    if (subscription->listenerPrev)
+      subscription->listenerPrev->listenerNext = subscription->listenerNext;
+    else
+      *subscription->listenerHead = subscription->listenerNext;
+  }
+
+  //! Removes a subscription from its event's list
+  static void UnlinkEvent(EventSubscription *subscription) noexcept
+  {
+    if (subscription->eventNext) subscription->eventNext->eventPrev = subscription->eventPrev;
+    if (subscription->eventPrev)
+      subscription->eventPrev->eventNext = subscription->eventNext;
+    else
+      subscription->owner->firstSubscription = subscription->eventNext;
+  }
+
+  //! Frees a subscription to EventPool::Default
+  static void Free(EventSubscription *subscription) noexcept
+  {
+    EventPool::Default().Deallocate(subscription, sizeof(EventSubscription), alignof(EventSubscription));
+  }
+
+  private:
+    //! Moves the list of another event over, pointing its subscriptions here
+    void Take(EventSubscriptions &other) noexcept
+    {
+      firstSubscription = other.firstSubscription;
+      other.firstSubscription = nullptr;
+      for (EventSubscription *subscription = firstSubscription; subscription; subscription = subscription->eventNext)
+        subscription->owner = this;
+    }
+};
+
+#ifdef EVENT_COROUTINES
+/*!
+ * \brief
+ *      Coroutine suspended on Event::Next, linked into the event's waiter list
+ */
+struct EventWaiter
+{
+  struct EventWaiters *owner = nullptr; //!< Waiters it is linked into, nullptr when not waiting
+  EventWaiter *prev = nullptr;          //!< Previous waiter
+  EventWaiter *next = nullptr;          //!< Next waiter
+  std::coroutine_handle<> coroutine;    //!< Coroutine to resume
+
+  //! Copies the arguments of the invoke about to resume it, given as signature_traits::References
+  void (*capture)(EventWaiter *waiter, const void *arguments) = nullptr;
+
+  //! Removes the waiter from its list in O(1)
+  void Unlink() noexcept;
+};
+
+/*!
+ * \brief
+ *      Coroutines waiting for an event to be invoked, resumed in the order they started waiting.
+ *      Copies start with no waiters, moves take them along
+ */
+struct EventWaiters
+{
+  EventWaiter *first = nullptr; //!< Longest waiting
+  EventWaiter *last = nullptr;  //!< Most recent
+
+  EventWaiters() = default;
+
+  //! Copies start with no waiters, the coroutines wait on the original event
+  EventWaiters(const EventWaiters&) noexcept {}
+
+  //! Takes the waiters of another event
+  EventWaiters(EventWaiters &&other) noexcept
+  {
+    Splice(other);
+  }
+
+  //! Keeps the waiters, they wait on this event whatever its calls
+  EventWaiters& operator=(const EventWaiters&) noexcept { return *this; }
+
+  //! Keeps the waiters, they wait on this event whatever its calls
+  EventWaiters& operator=(EventWaiters&&) noexcept { return *this; }
+
+  //! Unlinks the waiters, a destroyed event never resumes them
+  ~EventWaiters()
+  {
+    while (first) first->Unlink();
+  }
+
+  //! Adds a waiter at the end
+  void Push(EventWaiter *waiter) noexcept
+  {
+    waiter->owner = this;
+    waiter->prev = last;
+    waiter->next = nullptr;
+    (last ? last->next : first) = waiter;
+    last = waiter;
+  }
+
+  //! Moves the waiters of another list in front of these
+  void Splice(EventWaiters &other) noexcept
+  {
+    if (!other.first) return;
+    for (EventWaiter *waiter = other.first; waiter; waiter = waiter->next)
+      waiter->owner = this;
+    other.last->next = first;
+    (first ? first->prev : last) = other.last;
+    first = other.first;
+    other.first = other.last = nullptr;
+  }
+};
+
+inline void EventWaiter::Unlink() noexcept
+{
+  if (!owner) return;
+  (prev ? prev->next : owner->first) = next;
+  (next ? next->prev : owner->last) = prev;
+  owner = nullptr;
+  prev = next = nullptr;
+}
+#endif
+
+template<typename FunctionSignature, auto ...Callbacks>
+class StaticEvent; // forward declare
+
+template<typename FunctionSignature, bool KeepOrder, typename Allocator, typename Function>
+class ConcurrentEvent; // forward declare
+
+/*!
+ * \brief
+ *      Templated event system that holds clients callbacks to be
+ *      invoked on elsewhere
+ *
+ * \tparam FunctionSignature
+ *      Function signature of the callbacks to hold
+ *      NOTE: All callbacks must be of this type
+ *
+ * \tparam KeepOrder
+ *      Tells the system to invoke callbacks in the same order as they
+ *      were hooked.
+ *
+ * \tparam Allocator
+ *      Allocator for the call list. Rebound to struct 'Call'
+ *
+ * \tparam Function
+ *      Type erased callable each callback is stored in, such as Delegate<FunctionSignature, Bytes>
+ *      for a larger in place capacity or std::function<FunctionSignature>
+ */
+template<typename FunctionSignature, bool KeepOrder = true, typename Allocator = std::allocator<Call<FunctionSignature>>,
+         typename Function = Delegate<FunctionSignature>>
+class Event : private EventSubscriptions
+{
+    //! Shares the signature checks with the compile time event
+    template<typename, auto...> friend class StaticEvent;
+
+    //! Links its subscriptions into the event's list
+    friend class EventListener;
+
+    //! Uses the event as an immutable snapshot
+    template<typename, bool, typename, typename> friend class ConcurrentEvent;
+
+    /*!
+     * \brief
+     *      Assures that all functions in list Fs are non-member functions of a class
+     *
+     * \tparam Fs
+     *      List of function types
+     *
+     * \return
+     *      Returns true if all functions are non-member functions of a class
+     *      else static assert
+     */
+    template<typename ...Fns>
+    static constexpr bool class_member_exclusion()
+    {
+      static_assert(sizeof ...(Fns) > 0, "Calling variadic function with no parameters");
+      static_assert(!(... || std::is_member_function_pointer_v<Fns>), "A callback in variadic list Fs... is a class member");
+      return true;
+    }
+
+    /*!
+     * \brief
+     *      Used to check if the event can be invoked by the arguments passed in
+     *
+     * \tparam Args
+     *      List of type of arguments attempted to invoke the event with
+     *
+     * \return
+     *      Returns true if the event can be invoked, else static assert
+     */
+    template<typename ...Args>
+    static constexpr bool invocable()
+    {
+      static_assert(std::is_invocable_v<_Signature , Args...>, "Attempting to invoke event with differing arguments then the event function signature");
+      return true;
+    }
+
+    /*!
+     * \brief
+     *      Assures that a type is not contained within a variadic list
+     *
+     * \tparam Invalid_Type
+     *      Invalid type that list Types should not contain
+     *
+     * \tparam Types
+     *      List of types to check
+     *
+     * \return
+     *      Returns true if the type is not within the list, else static assert
+     */
+    template<typename Invalid_Type, typename ...Types>
+    static constexpr bool type_exclusion()
+    {
+      static_assert(sizeof ...(Types) > 0, "Calling variadic function with no parameters");
+      static_assert(!(... || std::is_same_v<Invalid_Type, Types>), "Invalid Type contained in Types variadic list");
+      return true;
+    }
+
+    /*!
+     * \brief
+     *      Assures that all functions in variadic Fs list belong to class C
+     *
+     * \tparam C
+     *      Type of class all functions Fs must be apart of
+     *
+     * \tparam Fs
+     *      List of function types
+     *
+     * \return
+     *      Returns true if all functions in list Fs belong to class C
+     *      else static assert
+     */
+    template<typename C, typename ...Fns>
+    static constexpr bool class_member_inclusion()
+    {
+      static_assert(std::is_class_v<C>, "Provided class pointer is not a class");
+      static_assert(sizeof ...(Fns) > 0, "Calling variadic function with no parameters");
+      static_assert((... && is_member_function_of<C, Fns>::value), "A callback in variadic list Fs... is not a non-static member of class C");
+      return true;
+    }
+
+    /*!
+     * \brief
+     *      Assures that all functions in list Fs are callable by this event
+     *
+     * \tparam Fs
+     *      List of functions to assure are compatible with this event function signature
+     *
+     * \return
+     *      Returns true if the list Fs is compatible with this event, else static assert
+     */
+    template<typename ...Fns>
+    static constexpr bool is_same_arg_list()
+    {
+      static_assert((... && parameter_equivalents<_Signature , Fns>::value), "Attempted to hook a callback that does not have the same parameter list as the event");
+      return true;
+    }
+
+  public:
+    using _Signature = FunctionSignature;                 //!< Function Signature
+    using _Allocator = Allocator;                         //!< Event allocator
+    using _Function  = Function;                          //!< Type erased callable
+    using _CallType  = Call<FunctionSignature, Function>; //!< Type of the call wrapper
+    using _Payload   = typename signature_traits<FunctionSignature>::Payload; //!< Arguments of one invoke
+    using _Batch     = typename signature_traits<FunctionSignature>::Batch;   //!< Callback taking a batch of payloads
+    static constexpr bool Ordered = KeepOrder;            //!< State of ordering
+
+    /*!
+     * \brief
+     *      Default Constructor
+     */
+    Event() = default;
+
+    /*!
+     * \brief
+     *      Constructor taking the allocator, rebound for the call list, slot map and group index,
+     *      such as an EventPoolAllocator of the event's own EventPool
+     *
+     * \param allocator
+     *      Allocator to copy
+     */
+    explicit Event(const Allocator &allocator)
+      : callList_(allocator), slots_(SlotAllocator(allocator)),
+        groups_(allocator), pending_(CallAllocator(allocator))
+    {}
+
+    /*!
+     * \brief
+     *      Makes room for 'count' callbacks in the call list, slot map and group index, so
+     *      hooking up to that many does not reallocate. Worth calling before hooking a
+     *      large number of subscribers at once, such as when a level loads
+     *      NOTE: During an invoke the call list is in use, room is made in the list of calls
+     *            hooked during the invoke instead
+     *
+     * \param count
+     *      Number of callbacks to make room for
+     */
+    void Reserve(size_t count)
+    {
+      if (invokeDepth_)
+        pending_.reserve(count > callList_.Size() ? count - callList_.Size() : 0);
+      else
+        callList_.Reserve(count);
+      slots_.reserve(count);
+      groups_.Reserve(count);
+#ifdef EVENT_PROFILE
+      profiles_.reserve(count);
+#endif
+    }
+
+    /*!
+     * \brief
+     *      Hooks a non-member function to the event system provided that the type of 'func_ptr'
+     *      matches that of 'FUNCTION_SIGNATURE'
+     *
+     * \tparam F
+     *      Type of function
+     *
+     * \param func_ptr
+     *      Pointer to non-member function to be hooked
+     *
+     * \return
+     *      Returns a handle corresponding to the hooked function.
+     *      NOTE: Must not be ignored when hooking lambdas, otherwise they become permanently hooked
+     */
+    template<typename Fn>
+    EVENT_HANDLE Hook(Fn &&func_ptr)
+    VERIFY_TYPE(class_member_exclusion<Fn>() && is_same_arg_list<Fn>())
+    {
+      return AddCall(_CallType(func_ptr, EVENT_HANDLE(0)), MakeKey(0, func_ptr));
+    }
+
+    /*!
+     * \brief
+     *      Hooks a non-static member function to the event system
+     *
+     * \tparam C
+     *      Type of user defined type
+     *
+     * \tparam F
+     *      Type of function pointer
+     *
+     * \param class_ref
+     *      Reference to the class that has non-static member function 'func_ptr'
+     *
+     * \param func_ptr
+     *      Pointer to non-static member function to hook
+     *
+     * \return
+     *      Returns handle corresponding to non-static member function hooked
+     */
+    template<typename C, typename Fn, typename = std::enable_if_t<!std::is_integral_v<C> && !std::is_enum_v<C>>>
+    EVENT_HANDLE Hook(C &class_ref, Fn func_ptr)
+    VERIFY_TYPE(class_member_inclusion<C, Fn>() && is_same_arg_list<Fn>())
+    {
+      return AddCall(_CallType(&class_ref, func_ptr, EVENT_HANDLE(0)), MakeKey(POINTER_INT_CAST(&class_ref), func_ptr));
+    }
+
+    /*!
+     * \brief
+     *      Hooks a non-member function or lambda with a priority. Callbacks with a higher priority
+     *      are invoked first, equal priorities in the order they were hooked. Hook without a
+     *      priority uses 0
+     *
+     * \tparam P
+     *      Type of priority, any integer or enumeration within the range of int32_t
+     *
+     * \tparam Fn
+     *      Type of function
+     *
+     * \param priority
+     *      Priority of the callback
+     *
+     * \param func_ptr
+     *      Pointer to non-member function to be hooked
+     *
+     * \return
+     *      Returns a handle corresponding to the hooked function
+     */
+    template<typename P, typename Fn, typename = std::enable_if_t<std::is_integral_v<P> || std::is_enum_v<P>>>
+    EVENT_HANDLE Hook(P priority, Fn &&func_ptr)
+    VERIFY_TYPE(class_member_exclusion<Fn>() && is_same_arg_list<Fn>())
+    {
+      static_assert(Ordered, "Hooking with a priority requires KeepOrder");
+      _CallType call(func_ptr, EVENT_HANDLE(0));
+      call.priority = PriorityOf(priority);
+      return AddCall(std::move(call), MakeKey(0, func_ptr));
+    }
+
+    /*!
+     * \brief
+     *      Hooks a non-static member function with a priority, see Hook(priority, func_ptr)
+     *
+     * \param priority
+     *      Priority of the callback
+     *
+     * \param class_ref
+     *      Reference to the class that has non-static member function 'func_ptr'
+     *
+     * \param func_ptr
+     *      Pointer to non-static member function to hook
+     *
+     * \return
+     *      Returns handle corresponding to non-static member function hooked
+     */
+    template<typename P, typename C, typename Fn, typename = std::enable_if_t<std::is_integral_v<P> || std::is_enum_v<P>>>
+    EVENT_HANDLE Hook(P priority, C &class_ref, Fn func_ptr)
+    VERIFY_TYPE(class_member_inclusion<C, Fn>() && is_same_arg_list<Fn>())
+    {
+      static_assert(Ordered, "Hooking with a priority requires KeepOrder");
+      _CallType call(&class_ref, func_ptr, EVENT_HANDLE(0));
+      call.priority = PriorityOf(priority);
+      return AddCall(std::move(call), MakeKey(POINTER_INT_CAST(&class_ref), func_ptr));
+    }
+
+    /*!
+     * \brief
+     *      Hooks a callback taking a whole batch of payloads at once. InvokeBatch calls it once
+     *      with the batch, Invoke calls it with a batch of one
+     *
+     * \tparam Fn
+     *      Type of callable, taking (const _Payload *payloads, size_t count)
+     *
+     * \param batch_fn
+     *      Callable to be hooked
+     *
+     * \return
+     *      Returns a handle corresponding to the hooked callable
+     *      NOTE: Must not be ignored, the callable can only be unhooked by handle
+     */
+    template<typename Fn>
+    EVENT_HANDLE HookBatch(Fn &&batch_fn)
+    {
+      using BatchCall = typename signature_traits<FunctionSignature>::BatchCall;
+      _CallType call(BatchCall{ _Batch(std::forward<Fn>(batch_fn)) }, EVENT_HANDLE(0));
+      call.batch = true;
+      return AddCall(std::move(call), CallKey());
+    }
+
+    /*!
+     * \brief
+     *      Hooks a non-member function or lambda for the next invoke only. The invoke unhooks it
+     *      as it reaches it, before calling it, and compacts the rest of the call list in the
+     *      same pass, so an event of N one-shot callbacks is cleared by one O(N) sweep
+     *
+     * \tparam Fn
+     *      Type of function
+     *
+     * \param func_ptr
+     *      Pointer to non-member function to be hooked
+     *
+     * \return
+     *      Returns a handle corresponding to the hooked function, valid until it is invoked
+     */
+    template<typename Fn>
+    EVENT_HANDLE HookOnce(Fn &&func_ptr)
+    VERIFY_TYPE(class_member_exclusion<Fn>() && is_same_arg_list<Fn>())
+    {
+      _CallType call(func_ptr, EVENT_HANDLE(0));
+      call.once = true;
+      ++onceCalls_;
+      return AddCall(std::move(call), MakeKey(0, func_ptr));
+    }
+
+    /*!
+     * \brief
+     *      Hooks a non-static member function for the next invoke only, see HookOnce(func_ptr)
+     *
+     * \param class_ref
+     *      Reference to the class that has non-static member function 'func_ptr'
+     *
+     * \param func_ptr
+     *      Pointer to non-static member function to hook
+     *
+     * \return
+     *      Returns handle corresponding to non-static member function hooked, valid until it is invoked
+     */
+    template<typename C, typename Fn>
+    EVENT_HANDLE HookOnce(C &class_ref, Fn func_ptr)
+    VERIFY_TYPE(class_member_inclusion<C, Fn>() && is_same_arg_list<Fn>())
+    {
+      _CallType call(&class_ref, func_ptr, EVENT_HANDLE(0));
+      call.once = true;
+      ++onceCalls_;
+      return AddCall(std::move(call), MakeKey(POINTER_INT_CAST(&class_ref), func_ptr));
+    }
+
+    /*!
+     * \brief
+     *      Hooks a cluster of non-member functions to the event system
+     *
+     * \tparam Fs
+     *      List of non-member function types
+     *
+     * \param func_ptrs
+     *      List of pointers to non-member functions to be hooked
+     *
+     * \return
+     *      Returns handle to corresponding to the cluster of non-member functions
+     */
+    template<typename ...Fns>
+    [[nodiscard]] EVENT_HANDLE HookFunctionCluster(Fns&&... func_ptrs)
+    VERIFY_TYPE(class_member_exclusion<Fns...>() && type_exclusion<EVENT_HANDLE, Fns...>() && is_same_arg_list<Fns...>())
+    {
+      EVENT_HANDLE cluster = EVENT_CLUSTER_MASK | ++clusterHandle_;
+      PACK_EXPAND(AddCall, _CallType(func_ptrs, EVENT_HANDLE(0)), MakeKey(cluster, func_ptrs))
+      return cluster;
+    }
+
+    /*!
+     * \brief
+     *      Hooks a cluster of non-static member functions to the event system
+     *
+     * \tparam C
+     *      Type of user defined type
+     *
+     * \tparam Fs
+     *      List of non-static member function types
+     *
+     * \param class_ref
+     *      Reference to the class that has non-static member functions 'func_ptrs'
+     *
+     * \param func_ptrs
+     *      List of pointers to non-static member functions to be hooked
+     *
+     * \return
+     *      Returns handle to corresponding to the cluster of non-static member functions
+     */
+    template<typename C, typename ...Fns>
+    [[nodiscard]] EVENT_HANDLE HookMethodCluster(C &class_ref, Fns... func_ptrs)
+    VERIFY_TYPE(class_member_inclusion<C, Fns...>() && type_exclusion<EVENT_HANDLE, Fns...>() && is_same_arg_list<Fns...>())
+    {
+      EVENT_HANDLE cluster = EVENT_CLUSTER_MASK | ++clusterHandle_;
+      PACK_EXPAND(AddCall, _CallType(&class_ref, func_ptrs, EVENT_HANDLE(0)), MakeKey(cluster, func_ptrs))
+      return cluster;
+    }
+
+    /*!
+     * \brief
+     *      Hooks every non-member function or lambda in a range, making room for all of them
+     *      up front when the range can be measured
+     *
+     * \tparam It
+     *      Type of iterator to the callbacks
+     *
+     * \tparam Out
+     *      Type of output iterator taking EVENT_HANDLE
+     *
+     * \param first
+     *      Iterator to the first callback
+     *
+     * \param last
+     *      Iterator past the last callback
+     *
+     * \param handles
+     *      Output iterator the handle of each callback is written to, in order
+     *
+     * \return
+     *      Returns the output iterator past the last handle written
+     */
+    template<typename It, typename Out>
+    Out HookRange(It first, It last, Out handles)
+    VERIFY_TYPE(class_member_exclusion<typename std::iterator_traits<It>::value_type>() && is_same_arg_list<typename std::iterator_traits<It>::value_type>())
+    {
+      ReserveRange(first, last);
+      for (; first != last; ++first, ++handles)
+        *handles = Hook(*first);
+      return handles;
+    }
+
+    /*!
+     * \brief
+     *      Hooks a non-static member function of every object in a range, making room for all
+     *      of them up front when the range can be measured
+     *
+     * \tparam It
+     *      Type of iterator to the objects, or to pointers to them
+     *
+     * \tparam Fn
+     *      Type of non-static member function
+     *
+     * \tparam Out
+     *      Type of output iterator taking EVENT_HANDLE
+     *
+     * \param first
+     *      Iterator to the first object
+     *
+     * \param last
+     *      Iterator past the last object
+     *
+     * \param func_ptr
+     *      Pointer to non-static member function to hook on each object
+     *
+     * \param handles
+     *      Output iterator the handle of each call is written to, in order
+     *
+     * \return
+     *      Returns the output iterator past the last handle written
+     */
+    template<typename It, typename Fn, typename Out>
+    Out HookRange(It first, It last, Fn func_ptr, Out handles)
+    VERIFY_TYPE(class_member_inclusion<std::remove_pointer_t<typename std::iterator_traits<It>::value_type>, Fn>() && is_same_arg_list<Fn>())
+    {
+      ReserveRange(first, last);
+      for (; first != last; ++first, ++handles)
+        *handles = Hook(ObjectOf(*first), func_ptr);
+      return handles;
+    }
+
+    /*!
+     * \brief
+     *      Invokes callbacks hooked to the event
+     *      NOTE: Callbacks unhooked during the invoke process are skipped, callbacks hooked
+     *            during it are first invoked by the next invoke. Both take effect when the
+     *            outermost invoke finishes
+     *      NOTE: Not thread safe against Hook or Unhook, see ConcurrentEvent
+     *      NOTE: Coroutines awaiting Next are resumed after the callbacks, see Next
+     *
+     * \tparam Args
+     *      Types of the parameters passed in
+     *
+     * \param args
+     *      Parameters to pass to each of the callback functions, forwarded without copying.
+     *      Each callback taking an argument by value receives its own copy, except the last
+     *      one when SetMoveToLast is enabled and the argument is an rvalue
+     *      NOTE: Must be the same arguments as the FUNCTION_SIGNATURE
+     */
+    template<typename ...Args>
+    void Invoke(Args&&... args)
+    VERIFY_TYPE(invocable<Args...>())
+    {
+#ifdef EVENT_COROUTINES
+      if (waiters_.first)
+        return InvokeAndResume(std::forward<Args>(args)...);
+#endif
+      InvokeCallbacks(std::forward<Args>(args)...);
+    }
+
+#ifdef EVENT_COROUTINES
+    /*!
+     * \brief
+     *      Awaitable returned by Next, kept in the awaiting coroutine's frame and linked into the
+     *      event's waiter list while suspended, so waiting never allocates. It holds the copy of
+     *      the arguments, so only events awaited through Next need copyable arguments
+     */
+    class NextAwaiter : private EventWaiter
+    {
+      public:
+        /*!
+         * \brief
+         *      Constructor
+         *
+         * \param event
+         *      Event to wait on
+         */
+        explicit NextAwaiter(Event &event) noexcept : event_(event)
+        {}
+
+        NextAwaiter(const NextAwaiter&) = delete;
+        NextAwaiter& operator=(const NextAwaiter&) = delete;
+
+        /*!
+         * \brief
+         *      Destructor, stops waiting in O(1) if the coroutine is destroyed while suspended
+         */
+        ~NextAwaiter()
+        {
+          this->Unlink();
+        }
+
+        //! Always suspends until the next invoke
+        [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+        //! Links the coroutine into the event's waiter list
+        void await_suspend(std::coroutine_handle<> coroutine) noexcept
+        {
+          this->coroutine = coroutine;
+          this->capture = &Capture;
+          event_.waiters_.Push(this);
+        }
+
+        /*!
+         * \brief
+         *      Gets the arguments of the invoke that resumed the coroutine
+         *
+         * \return
+         *      Returns nothing for events without parameters, a copy of the argument for events
+         *      with one, else a _Payload tuple of the arguments
+         */
+        auto await_resume()
+        {
+          if constexpr (std::tuple_size_v<_Payload> == 1)
+            return std::get<0>(std::move(*payload_));
+          else if constexpr (std::tuple_size_v<_Payload> > 1)
+            return std::move(*payload_);
+        }
+
+      private:
+        Event &event_;                     //!< Event waited on
+        std::optional<_Payload> payload_;  //!< Arguments of the invoke that resumed the coroutine
+
+        //! Copies the arguments of the invoke resuming the waiter, see EventWaiter::capture
+        static void Capture(EventWaiter *waiter, const void *arguments)
+        {
+          using References = typename signature_traits<FunctionSignature>::References;
+          static_cast<NextAwaiter*>(waiter)->payload_.emplace(std::make_from_tuple<_Payload>(*static_cast<const References*>(arguments)));
+        }
+    };
+
+    /*!
+     * \brief
+     *      Suspends a coroutine until the event is next invoked, 'co_await event.Next()'. Invoke
+     *      resumes the waiting coroutines after its callbacks, in the order they started
+     *      waiting, and hands each a copy of the arguments. Coroutines that wait again while
+     *      resumed wait for the invoke after
+     *      NOTE: Only available when compiled as C++20 with coroutine support
+     *
+     * \return
+     *      Returns the awaitable
+     */
+    [[nodiscard]] NextAwaiter Next()
+    {
+      static_assert(std::is_copy_constructible_v<_Payload>, "Awaiting an event requires copyable arguments");
+      return NextAwaiter(*this);
+    }
+
+    /*!
+     * \brief
+     *      Getter for the number of coroutines waiting on Next
+     *
+     * \return
+     *      Returns the number of waiters
+     */
+    [[nodiscard]] size_t WaiterCount() const
+    {
+      size_t count = 0;
+      for (const EventWaiter *waiter = waiters_.first; waiter; waiter = waiter->next)
+        ++count;
+      return count;
+    }
+#endif
+
+#ifdef EVENT_PROFILE
+    /*!
+     * \brief
+     *      Gets the timings of a callback, recorded by Invoke
+     *
+     * \param handle
+     *      Handle of the callback
+     *
+     * \return
+     *      Returns the profile, or nullptr if the handle is not hooked
+     */
+    [[nodiscard]] const EventProfile* Profile(EVENT_HANDLE handle) const
+    {
+      uint32_t id = uint32_t(GET_ID(handle));
+      if (GET_CLUSTER(handle) || id >= slots_.size() || slots_[id].generation != GET_GENERATION(handle))
+        return nullptr;
+      return &profiles_[id];
+    }
+
+    /*!
+     * \brief
+     *      Clears the timings of every callback
+     */
+    void ResetProfiles()
+    {
+      std::fill(profiles_.begin(), profiles_.end(), EventProfile());
+    }
+
+    /*!
+     * \brief
+     *      Sets how often invokes are profiled
+     *
+     * \param every
+     *      Profiles every Nth invoke, 1 profiles them all
+     */
+    void SetProfileSampling(size_t every)
+    {
+      profileSampling_ = every ? every : 1;
+    }
+#endif
+
+    /*!
+     * \brief
+     *      Lets the last callback of an invoke take rvalue arguments by move instead of copy
+     *      NOTE: For unordered events the last callback changes as callbacks are unhooked
+     *
+     * \param move
+     *      True to move rvalue arguments into the last callback
+     */
+    void SetMoveToLast(bool move)
+    {
+      moveToLast_ = move;
+    }
+
+    /*!
+     * \brief
+     *      Invokes callbacks hooked to the event in order until the predicate accepts one's result
+     *
+     * \tparam Predicate
+     *      Callable taking the result of a callback, or nothing for events returning void
+     *
+     * \tparam Args
+     *      Types of the parameters passed in
+     *
+     * \param pred
+     *      Returns true to stop the invoke, such as when an input event was handled
+     *
+     * \param args
+     *      Parameters to pass to each of the callback functions
+     *      NOTE: Must be the same arguments as the FUNCTION_SIGNATURE
+     *
+     * \return
+     *      Returns true if the predicate stopped the invoke
+     */
+    template<typename Predicate, typename ...Args>
+    bool InvokeUntil(Predicate &&pred, Args&&... args)
+    VERIFY_TYPE(invocable<Args...>())
+    {
+      InvokeScope scope(*this);
+      for (size_t i = 0; i < callList_.Size(); ++i)
+      {
+        if (callList_.IsRemoved(i)) continue;
+        if (callList_.IsOnce(i)) RemoveOnce(i);
+        if constexpr (std::is_void_v<typename signature_traits<FunctionSignature>::Return>)
+        {
+          callList_.Callable(i)(args...);
+          if (pred()) return true;
+        }
+        else if (pred(callList_.Callable(i)(args...)))
+          return true;
+      }
+      return false;
+    }
+
+    /*!
+     * \brief
+     *      Invokes callbacks hooked to the event in order, handing each result to a collector.
+     *      See CollectFirst, CollectLast, CollectAnyTrue, CollectSum, CollectMin and CollectMax
+     *
+     * \tparam Collector
+     *      Callable taking the result of a callback and returning false once it needs no more
+     *
+     * \tparam Args
+     *      Types of the parameters passed in
+     *
+     * \param collector
+     *      Receives each result, held by the caller so nothing is allocated
+     *
+     * \param args
+     *      Parameters to pass to each of the callback functions
+     *      NOTE: Must be the same arguments as the FUNCTION_SIGNATURE
+     *
+     * \return
+     *      Returns true if the collector stopped the invoke early
+     */
+    template<typename Collector, typename ...Args>
+    bool InvokeCollect(Collector &collector, Args&&... args)
+    VERIFY_TYPE(invocable<Args...>())
+    {
+      static_assert(!std::is_void_v<typename signature_traits<FunctionSignature>::Return>, "Collecting the results of an event returning void");
+      return InvokeUntil([&collector](auto &&result) { return !collector(std::forward<decltype(result)>(result)); }, args...);
+    }
+
+    /*!
+     * \brief
+     *      Invokes callbacks hooked to the event once per payload. Callbacks are the outer
+     *      loop and payloads the inner one, so each callback stays hot in cache for the batch.
+     *      Callbacks hooked by HookBatch are called once with the whole batch
+     *
+     * \param payloads
+     *      Arguments of each invoke
+     *
+     * \param count
+     *      Number of payloads
+     */
+    void InvokeBatch(const _Payload *payloads, size_t count)
+    {
+      InvokeScope scope(*this);
+      for (size_t i = 0; i < callList_.Size(); ++i)
+      {
+        if (callList_.IsRemoved(i)) continue;
+        const _Function &function = callList_.Callable(i);
+        if (callList_.IsOnce(i))
+        {
+          // Takes the first payload only, as the first of the invokes in the batch
+          RemoveOnce(i);
+          if (count) std::apply(function, payloads[0]);
+        }
+        else if (callList_.IsBatch(i))
+          function.template target<typename signature_traits<FunctionSignature>::BatchCall>()->batch(payloads, count);
+        else
+          for (size_t payload = 0; payload < count && !callList_.IsRemoved(i); ++payload)
+            std::apply(function, payloads[payload]);
+      }
+    }
+
+    /*!
+     * \brief
+     *      Invokes callbacks hooked to the event once per payload of a contiguous container
+     *
+     * \tparam Container
+     *      Contiguous container of _Payload, such as std::vector or std::array
+     *
+     * \param payloads
+     *      Arguments of each invoke
+     */
+    template<typename Container>
+    void InvokeBatch(const Container &payloads)
+    {
+      InvokeBatch(std::data(payloads), std::size(payloads));
+    }
+
+    /*!
+     * \brief
+     *      Invokes callbacks hooked to the event, splitting the call list into chunks
+     *      that run in parallel on an executor. Returns once every callback has run
+     *      NOTE: Only for unordered events, or ordered events marked order independent
+     *      NOTE: Callbacks must not hook or unhook this event during a parallel invoke
+     *
+     * \tparam Executor
+     *      Type providing ParallelFor(count, grain, body), such as EventThreadPool
+     *
+     * \tparam Args
+     *      Types of the parameters passed in
+     *
+     * \param executor
+     *      Executor the chunks run on
+     *
+     * \param args
+     *      Parameters to pass to each of the callback functions, shared by every thread
+     *      NOTE: Must be the same arguments as the FUNCTION_SIGNATURE
+     */
+    template<typename Executor, typename ...Args>
+    void InvokeParallel(Executor &executor, Args&&... args)
+    VERIFY_TYPE(invocable<Args...>())
+    {
+      assert((!Ordered || orderIndependent_) && "ERROR : Parallel invoke of an ordered event not marked order independent");
+      InvokeScope scope(*this);
+      executor.ParallelFor(callList_.Size(), parallelGrain_, [this, &args...](size_t begin, size_t end)
+      {
+        for (size_t i = begin; i < end; ++i)
+          if (!callList_.IsRemoved(i))
+            callList_.Callable(i)(args...);
+      });
+
+      // One-shot calls cannot be unhooked from the workers, they are unhooked once all have run
+      for (size_t i = 0; onceCalls_ && i < callList_.Size(); ++i)
+        if (!callList_.IsRemoved(i) && callList_.IsOnce(i))
+          RemoveOnce(i);
+    }
+
+    /*!
+     * \brief
+     *      Marks an ordered event as safe to invoke in parallel
+     *
+     * \param independent
+     *      True if the callbacks do not depend on the order they run in
+     */
+    void SetOrderIndependent(bool independent)
+    {
+      orderIndependent_ = independent;
+    }
+
+    /*!
+     * \brief
+     *      Sets how many callbacks a parallel invoke runs per chunk
+     *
+     * \param grain
+     *      Callbacks per chunk, larger for cheap callbacks, smaller for expensive ones
+     */
+    void SetParallelGrain(size_t grain)
+    {
+      parallelGrain_ = grain ? grain : 1;
+    }
+
+    /*!
+     * \brief
+     *      Unhooks non-member function from event
+     *
+     * \tparam F
+     *      Type of function pointer
+     *
+     * \param func_ptr
+     *      Pointer to non-member function to unhook
+     */
+    template<typename Fn>
+    void Unhook(Fn func_ptr)
+    VERIFY_TYPE(class_member_exclusion<Fn>())
+    {
+      RemoveKey(MakeKey(0, func_ptr));
+    }
+
+    /*!
+     * \brief
+     *      Unhooks non-static member function from event
+     *
+     * \tparam C
+     *      Type of user defined type
+     *
+     * \tparam F
+     *      Type of non-static member function
+     *
+     * \param class_ref
+     *      Reference to user defined type that contains the non-static member function 'func_ptr'
+     *
+     * \param func_ptr
+     *      Pointer to non-static member function to unhook
+     */
+    template<typename C, typename Fn>
+    void Unhook(C &class_ref, Fn func_ptr)
+    VERIFY_TYPE(class_member_inclusion<C, Fn>())
+    {
+      RemoveKey(MakeKey(POINTER_INT_CAST(&class_ref), func_ptr));
+    }
+
+    /*!
+     * \brief
+     *      Unhooks a function that a handle corresponds to in O(1)
+     *      NOTE: Attempting to use a handle given for a cluster, or a handle
+     *            that was already unhooked, will not remove anything
+     *
+     * \param handle
+     *      Handle corresponding to the function to unhook
+     */
+    void Unhook(EVENT_HANDLE handle)
+    {
+      RemoveCall(handle);
+    }
+
+    /*!
+     * \brief
+     *      Unhooks the cluster of functions corresponding to the handle
+     *
+     * \param handle
+     *      Handle corresponding to the cluster of cuntions hooked by Hook##Cluster functions
+     */
+    void UnhookCluster(EVENT_HANDLE handle)
+    {
+      if (GET_CLUSTER(handle)) RemoveCluster(handle);
+    }
+
+    /*!
+     * \brief
+     *      Unhooks all non-static member functions hooked with the
+     *      user defined type
+     *
+     * \tparam C
+     *      Type of user defined type
+     *
+     * \param class_ref
+     *      Reference to class has non-static member functions hooked to event
+     */
+    template<typename C>
+    void UnhookClass(C &class_ref)
+    {
+      static_assert(std::is_class_v<C>, "Class pointer provided not a pointer to a class");
+      RemoveCluster(POINTER_INT_CAST(&class_ref));
+    }
+
+    /*!
+     * \brief
+     *      Unhooks a list of non-member functions hooked to the event
+     *
+     * \tparam Fs
+     *      List of non-member function types
+     *
+     * \param func_ptrs
+     *      List of non-member functions to unhook from event
+     */
+    template<typename ...Fns>
+    void UnhookFunctions(Fns ...func_ptrs)
+    VERIFY_TYPE(class_member_exclusion<Fns...>() && type_exclusion<EVENT_HANDLE, Fns...>())
+    {
+      PACK_EXPAND(RemoveKey, MakeKey(0, func_ptrs), false)
+      Compact(1);
+    }
+
+    /*!
+     * \brief
+     *      Unhooks a list of non-static member functions both hooked to event
+     *      and contained within the class of type C
+     *
+     * \tparam C
+     *      Type of user defined type
+     *
+     * \tparam Fs
+     *      List of non-static member function types
+     *
+     * \param class_ref
+     *      Reference to class that contains the non-static member functions
+     *      to unhook
+     *
+     * \param func_ptrs
+     *      List of non-static member functions contained in class C to unhook from event
+     *
+     */
+    template<typename C, typename ...Fns>
+    void UnhookMethods(C &class_ref, Fns ...func_ptrs)
+    VERIFY_TYPE(class_member_inclusion<C, Fns...>() && type_exclusion<EVENT_HANDLE, Fns...>())
+    {
+      PACK_EXPAND(RemoveKey, MakeKey(POINTER_INT_CAST(&class_ref), func_ptrs), false)
+      Compact(1);
+    }
+
+    /*!
+     * \brief
+     *      Unhooks every handle in a range, then compacts the call list at most once
+     *      NOTE: Cluster handles and handles already unhooked are skipped, as with Unhook
+     *
+     * \tparam It
+     *      Type of iterator to EVENT_HANDLE
+     *
+     * \param first
+     *      Iterator to the first handle
+     *
+     * \param last
+     *      Iterator past the last handle
+     */
+    template<typename It>
+    void UnhookRange(It first, It last)
+    {
+      static_assert(std::is_convertible_v<typename std::iterator_traits<It>::value_type, EVENT_HANDLE>, "UnhookRange takes a range of EVENT_HANDLE");
+      for (; first != last; ++first)
+        RemoveCall(*first, false);
+      Compact(1);
+    }
+
+    /*!
+     * \brief
+     *      Getter for how many callbacks are stored within this event
+     *
+     * \return
+     *      Returns number of callbacks hooked to this event
+     */
+    [[nodiscard]] size_t CallListSize() const
+    {
+        return callList_.Size() + pending_.size() - removedCount_;
+    }
+
+    /*!
+     * \brief
+     *      Getter for the bytes held by the event: itself, the call list, slot map, group index
+     *      and calls hooked during an invoke
+     *      NOTE: Callables too large for a Delegate's in place storage are not counted
+     *
+     * \return
+     *      Returns the number of bytes
+     */
+    [[nodiscard]] size_t MemoryUsage() const
+    {
+      size_t bytes = sizeof(*this) + callList_.MemoryUsage() + groups_.MemoryUsage()
+                   + slots_.capacity() * sizeof(Slot) + pending_.capacity() * sizeof(_CallType);
+#ifdef EVENT_PROFILE
+      bytes += profiles_.capacity() * sizeof(EventProfile);
+#endif
+      return bytes;
+    }
+
+    /*!
+     * \brief
+     *      Clears the call list
+     */
+    void Clear()
+    {
+        for (size_t i = 0; i < callList_.Size(); ++i)
+        {
+          if (callList_.IsRemoved(i)) continue;
+          FreeSlot(uint32_t(GET_ID(callList_.Handle(i))));
+          callList_.MarkRemoved(i, !invokeDepth_);
+        }
+        for (const auto &call : pending_)
+          if (!call.removed)
+            FreeSlot(uint32_t(GET_ID(call.handle)));
+
+        pending_.clear();
+        groups_.Clear();
+        removedCount_ = callList_.Size();
+        onceCalls_ = 0;
+        Compact();
+        Detach();
+    }
+  private:
+    //! Allocator rebound to the call wrapper
+    using CallAllocator = typename std::allocator_traits<_Allocator>::template rebind_alloc<_CallType>;
+
+    /*!
+     * \brief
+     *      Identity of a hooked function, used to unhook it by address
+     */
+    struct CallKey
+    {
+      std::uintptr_t group = 0;         //!< Class address, cluster handle or 0 for non-member functions
+      std::uintptr_t function[2] = {};  //!< Bits of the function or member function pointer, 0 for lambdas
+
+      /*!
+       * \brief
+       *      Checks if the key can be looked up, lambdas have no address to unhook by
+       *
+       * \return
+       *      Returns true if the key identifies a function or member function
+       */
+      [[nodiscard]] bool Addressable() const
+      {
+        return function[0] || function[1];
+      }
+
+      /*!
+       * \brief
+       *      Equality operator
+       *
+       * \param other
+       *      Key to compare with
+       *
+       * \return
+       *      Returns true if both keys identify the same function
+       */
+      bool operator==(const CallKey &other) const
+      {
+        return group == other.group && function[0] == other.function[0] && function[1] == other.function[1];
+      }
+    };
+
+    /*!
+     * \brief
+     *      Entry of the slot map indexed by EVENT_HANDLE
+     */
+    struct Slot
+    {
+      uint32_t index;      //!< Position of the call in the call list, or the next free slot
+      uint32_t generation; //!< Generation of handles to this slot, bumped each time it is freed
+      uint32_t prev;       //!< Previous slot hooked with the same class, cluster or function
+      uint32_t next;       //!< Next slot hooked with the same class, cluster or function
+      CallKey key;         //!< Identity of the call occupying the slot
+    };
+
+    //! Allocator rebound to the slot map
+    using SlotAllocator = typename std::allocator_traits<_Allocator>::template rebind_alloc<Slot>;
+
+    /*!
+     * \brief
+     *      Open addressing map from a list key (class address, cluster handle or function address)
+     *      to the first slot of its list. One contiguous table probed linearly, with keys mixed
+     *      so aligned addresses spread over the whole table. Key 0 marks an empty entry
+     */
+    class GroupIndex
+    {
+        //! Entry of the table
+        struct Entry
+        {
+          std::uintptr_t key; //!< List key, 0 if empty
+          uint32_t head;      //!< First slot of the list
+        };
+
+        //! Allocator rebound to the table
+        using EntryAllocator = typename std::allocator_traits<_Allocator>::template rebind_alloc<Entry>;
+
+      public:
+        /*!
+         * \brief
+         *      Constructor
+         *
+         * \param allocator
+         *      Allocator of the event, rebound to the table
+         */
+        explicit GroupIndex(const _Allocator &allocator = _Allocator()) : table_(EntryAllocator(allocator))
+        {}
+
+        /*!
+         * \brief
+         *      Finds the head of a list
+         *
+         * \param key
+         *      List key
+         *
+         * \return
+         *      Returns a pointer to the head, or nullptr if the list is empty
+         */
+        uint32_t* Find(std::uintptr_t key)
+        {
+          if (table_.empty()) return nullptr;
+          Entry &entry = table_[Probe(key)];
+          return entry.key ? &entry.head : nullptr;
+        }
+
+        /*!
+         * \brief
+         *      Adds a list if it is not indexed yet
+         *
+         * \param key
+         *      List key
+         *
+         * \param head
+         *      First slot of the list if it is added
+         *
+         * \return
+         *      Returns a pointer to the head of the list and true if it was added
+         */
+        std::pair<uint32_t*, bool> TryEmplace(std::uintptr_t key, uint32_t head)
+        {
+          if ((size_ + 1) * 4 > table_.size() * 3)
+            Grow(table_.size() ? table_.size() * 2 : 16);
+
+          Entry &entry = table_[Probe(key)];
+          if (entry.key) return { &entry.head, false };
+          entry = { key, head };
+          ++size_;
+          return { &entry.head, true };
+        }
+
+        /*!
+         * \brief
+         *      Removes a list, shifting the entries probed past it back so no tombstone is left
+         *
+         * \param key
+         *      List key
+         */
+        void Erase(std::uintptr_t key)
+        {
+          if (table_.empty()) return;
+          size_t mask = table_.size() - 1;
+          size_t hole = Probe(key);
+          if (!table_[hole].key) return;
+
+          for (size_t i = (hole + 1) & mask; table_[i].key; i = (i + 1) & mask)
+          {
+            size_t home = Mix(table_[i].key) & mask;
+            if (((i - home) & mask) >= ((i - hole) & mask))
+            {
+              table_[hole] = table_[i];
+              hole = i;
+            }
+          }
+          table_[hole].key = 0;
+          --size_;
+        }
+
+        //! Bytes of the table
+        [[nodiscard]] size_t MemoryUsage() const
+        {
+          return table_.capacity() * sizeof(Entry);
+        }
+
+        /*!
+         * \brief
+         *      Grows the table to index 'count' lists without growing again
+         *
+         * \param count
+         *      Number of lists to make room for
+         */
+        void Reserve(size_t count)
+        {
+          size_t capacity = table_.size() ? table_.size() : 16;
+          while (count * 4 > capacity * 3) capacity *= 2;
+          if (capacity > table_.size()) Grow(capacity);
+        }
+
+        /*!
+         * \brief
+         *      Removes every list, keeping the table
+         */
+        void Clear()
+        {
+          std::fill(table_.begin(), table_.end(), Entry{ 0, 0 });
+          size_ = 0;
+        }
+
+      private:
+        std::vector<Entry, EntryAllocator> table_; //!< Power of two sized table
+        size_t size_ = 0;                          //!< Lists indexed
+
+        /*!
+         * \brief
+         *      Mixes the bits of a key, murmur3's finalizer
+         */
+        static size_t Mix(std::uintptr_t key)
+        {
+          uint64_t x = key;
+          x ^= x >> 33;
+          x *= 0xff51afd7ed558ccdull;
+          x ^= x >> 33;
+          return size_t(x);
+        }
+
+        /*!
+         * \brief
+         *      Finds the entry of a key, or the empty entry it would take
+         */
+        size_t Probe(std::uintptr_t key) const
+        {
+          size_t mask = table_.size() - 1;
+          size_t i = Mix(key) & mask;
+          while (table_[i].key && table_[i].key != key)
+            i = (i + 1) & mask;
+          return i;
+        }
+
+        /*!
+         * \brief
+         *      Moves to a larger table, reinserting every entry
+         *
+         * \param capacity
+         *      Size of the new table, a power of two
+         */
+        void Grow(size_t capacity)
+        {
+          std::vector<Entry, EntryAllocator> old(capacity, Entry{ 0, 0 }, table_.get_allocator());
+          old.swap(table_);
+          for (const Entry &entry : old)
+            if (entry.key)
+              table_[Probe(entry.key)] = entry;
+        }
+    };
+
+    /*!
+     * \brief
+     *      Call list stored as parallel arrays. Invoking streams only the callables and their
+     *      flags, compaction and reindexing touch the handles, and priority inserts binary
+     *      search the priorities alone
+     */
+    class CallList
+    {
+        //! Allocators rebound to each array
+        using FunctionAllocator = typename std::allocator_traits<_Allocator>::template rebind_alloc<_Function>;
+        using HandleAllocator   = typename std::allocator_traits<_Allocator>::template rebind_alloc<EVENT_HANDLE>;
+        using PriorityAllocator = typename std::allocator_traits<_Allocator>::template rebind_alloc<int32_t>;
+        using FlagAllocator     = typename std::allocator_traits<_Allocator>::template rebind_alloc<uint8_t>;
+
+      public:
+        static constexpr uint8_t Removed = 1; //!< Unhooked, skipped by invoke until compacted
+        static constexpr uint8_t Batch = 2;   //!< Hooked by HookBatch
+        static constexpr uint8_t Once = 4;    //!< Hooked by HookOnce
+
+        /*!
+         * \brief
+         *      Constructor
+         *
+         * \param allocator
+         *      Allocator of the event, rebound to each array
+         */
+        explicit CallList(const _Allocator &allocator = _Allocator())
+          : functions_(FunctionAllocator(allocator)), handles_(HandleAllocator(allocator)),
+            priorities_(PriorityAllocator(allocator)), flags_(FlagAllocator(allocator))
+        {}
+
+        //! Number of calls, removed ones included
+        [[nodiscard]] size_t Size() const { return handles_.size(); }
+
+        //! Checks if there are no calls
+        [[nodiscard]] bool Empty() const { return handles_.empty(); }
+
+        //! Number of calls the arrays hold before reallocating
+        [[nodiscard]] size_t Capacity() const { return handles_.capacity(); }
+
+        //! Bytes of the arrays
+        [[nodiscard]] size_t MemoryUsage() const
+        {
+          return functions_.capacity() * sizeof(_Function) + handles_.capacity() * sizeof(EVENT_HANDLE)
+               + priorities_.capacity() * sizeof(int32_t) + flags_.capacity() * sizeof(uint8_t);
+        }
+
+        //! Makes room for 'count' calls in every array
+        void Reserve(size_t count)
+        {
+          functions_.reserve(count);
+          handles_.reserve(count);
+          priorities_.reserve(count);
+          flags_.reserve(count);
+        }
+
+        //! Callables, stable while invoking
+        [[nodiscard]] const _Function* Functions() const { return functions_.data(); }
+
+        //! Flags of each call, stable while invoking
+        [[nodiscard]] const uint8_t* Flags() const { return flags_.data(); }
+
+        //! Callable of a call
+        [[nodiscard]] const _Function& Callable(size_t index) const { return functions_[index]; }
+
+        //! Handle of a call
+        [[nodiscard]] EVENT_HANDLE Handle(size_t index) const { return handles_[index]; }
+
+        //! Priority of a call
+        [[nodiscard]] int32_t Priority(size_t index) const { return priorities_[index]; }
+
+        //! Checks if a call is removed
+        [[nodiscard]] bool IsRemoved(size_t index) const { return flags_[index] & Removed; }
+
+        //! Checks if a call was hooked by HookBatch
+        [[nodiscard]] bool IsBatch(size_t index) const { return flags_[index] & Batch; }
+
+        //! Checks if a call was hooked by HookOnce
+        [[nodiscard]] bool IsOnce(size_t index) const { return flags_[index] & Once; }
+
+        /*!
+         * \brief
+         *      Marks a call as removed
+         *
+         * \param index
+         *      Position of the call
+         *
+         * \param release
+         *      True to destroy the callable now, false while it may still be running
+         */
+        void MarkRemoved(size_t index, bool release)
+        {
+          flags_[index] |= Removed;
+          if (release) functions_[index] = _Function();
+        }
+
+        /*!
+         * \brief
+         *      Appends a call
+         *
+         * \param call
+         *      Call to append
+         */
+        void PushBack(_CallType &&call)
+        {
+          functions_.emplace_back(std::move(call.function));
+          handles_.emplace_back(call.handle);
+          priorities_.emplace_back(call.priority);
+          flags_.emplace_back(FlagsOf(call));
+        }
+
+        /*!
+         * \brief
+         *      Inserts a call, moving the calls after it up one
+         *
+         * \param index
+         *      Position of the call
+         *
+         * \param call
+         *      Call to insert
+         */
+        void Insert(size_t index, _CallType &&call)
+        {
+          functions_.insert(functions_.begin() + index, std::move(call.function));
+          handles_.insert(handles_.begin() + index, call.handle);
+          priorities_.insert(priorities_.begin() + index, call.priority);
+          flags_.insert(flags_.begin() + index, FlagsOf(call));
+        }
+
+        /*!
+         * \brief
+         *      Moves a call to another position, overwriting the call there
+         *
+         * \param to
+         *      Position to move to
+         *
+         * \param from
+         *      Position to move from, left to be overwritten or truncated
+         */
+        void Move(size_t to, size_t from)
+        {
+          functions_[to] = std::move(functions_[from]);
+          handles_[to] = handles_[from];
+          priorities_[to] = priorities_[from];
+          flags_[to] = flags_[from];
+        }
+
+        /*!
+         * \brief
+         *      Erases every call from a position on
+         *
+         * \param size
+         *      Number of calls to keep
+         */
+        void Truncate(size_t size)
+        {
+          functions_.erase(functions_.begin() + size, functions_.end());
+          handles_.resize(size);
+          priorities_.resize(size);
+          flags_.resize(size);
+        }
+
+        /*!
+         * \brief
+         *      Finds the position after every call of the same or higher priority
+         *
+         * \param priority
+         *      Priority of the call to place
+         *
+         * \return
+         *      Returns the position
+         */
+        [[nodiscard]] size_t UpperBound(int32_t priority) const
+        {
+          return size_t(std::upper_bound(priorities_.begin(), priorities_.end(), priority, std::greater<int32_t>()) - priorities_.begin());
+        }
+
+        /*!
+         * \brief
+         *      Checks if the calls from a position on are in priority order
+         *
+         * \param first
+         *      Position to check from
+         */
+        [[nodiscard]] bool SortedFrom(size_t first) const
+        {
+          return std::is_sorted(priorities_.begin() + first, priorities_.end(), std::greater<int32_t>());
+        }
+
+        /*!
+         * \brief
+         *      Stable sorts the calls by descending priority
+         */
+        void SortByPriority()
+        {
+          std::vector<uint32_t> order(Size());
+          for (size_t i = 0; i < order.size(); ++i)
+            order[i] = uint32_t(i);
+          std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) { return priorities_[a] > priorities_[b]; });
+
+          CallList sorted(*this, order.size());
+          for (uint32_t i : order)
+          {
+            sorted.functions_.emplace_back(std::move(functions_[i]));
+            sorted.handles_.emplace_back(handles_[i]);
+            sorted.priorities_.emplace_back(priorities_[i]);
+            sorted.flags_.emplace_back(flags_[i]);
+          }
+          std::swap(*this, sorted);
+        }
+
+      private:
+        std::vector<_Function, FunctionAllocator> functions_; //!< Callables
+        std::vector<EVENT_HANDLE, HandleAllocator> handles_;  //!< Handles
+        std::vector<int32_t, PriorityAllocator> priorities_;  //!< Priorities, descending
+        std::vector<uint8_t, FlagAllocator> flags_;           //!< Removed, Batch and Once flags
+
+        /*!
+         * \brief
+         *      Constructor for an empty list sharing the allocators of another
+         *
+         * \param other
+         *      List to take the allocators of
+         *
+         * \param capacity
+         *      Calls to reserve room for
+         */
+        CallList(const CallList &other, size_t capacity)
+          : functions_(other.functions_.get_allocator()), handles_(other.handles_.get_allocator()),
+            priorities_(other.priorities_.get_allocator()), flags_(other.flags_.get_allocator())
+        {
+          functions_.reserve(capacity);
+          handles_.reserve(capacity);
+          priorities_.reserve(capacity);
+          flags_.reserve(capacity);
+        }
+
+        //! Flags of a call wrapper
+        static uint8_t FlagsOf(const _CallType &call)
+        {
+          return uint8_t((call.removed ? Removed : 0) | (call.batch ? Batch : 0) | (call.once ? Once : 0));
+        }
+    };
+
+    //! Type of the list of calls hooked during an invoke
+    using PendingListType = std::vector<_CallType, CallAllocator>;
+
+    static constexpr uint32_t NoSlot = uint32_t(EVENT_ID_MASK);                                       //!< End of the free list
+    static constexpr uint32_t MaxGeneration = uint32_t(EVENT_GENERATION_MASK >> sizeof(uint32_t) * 8); //!< Last usable generation
+
+    CallList callList_;                       //!< List of callbacks, kept dense for invoke
+    std::vector<Slot, SlotAllocator> slots_;  //!< Slot map from handle to call
+    GroupIndex groups_;                       //!< Slots of each class, cluster and function, linked through Slot::next
+    uint32_t freeSlot_ = NoSlot;              //!< Head of the free slot list
+    EVENT_HANDLE clusterHandle_ = 0;          //!< Id of the last cluster hooked
+    size_t invokeDepth_ = 0;                  //!< Number of invokes in progress, nested ones included
+    size_t removedCount_ = 0;                 //!< Calls unhooked but not yet erased from the call list
+    size_t onceCalls_ = 0;                    //!< Calls hooked by HookOnce, may count ones since unhooked, reset by the outermost invoke
+    size_t parallelGrain_ = 64;               //!< Callbacks per chunk of a parallel invoke
+    bool orderIndependent_ = false;           //!< Allows parallel invokes of an ordered event
+    bool moveToLast_ = false;                 //!< Moves rvalue arguments into the last callback
+#ifdef EVENT_PROFILE
+    std::vector<EventProfile> profiles_;                 //!< Timings of each slot
+    size_t profileSampling_ = EVENT_PROFILE_SAMPLING;    //!< Profiles every Nth invoke
+    size_t profileInvokes_ = 0;                          //!< Invokes so far
+#endif
+
+    //! Calls hooked during an invoke, added when the outermost invoke finishes
+    PendingListType pending_;
+
+#ifdef EVENT_COROUTINES
+    EventWaiters waiters_; //!< Coroutines suspended on Next
+#endif
+
+    /*!
+     * \brief
+     *      Tracks the invoke depth, applying deferred changes when the outermost invoke
+     *      finishes, even if a callback throws
+     */
+    struct InvokeScope
+    {
+      /*!
+       * \brief
+       *      Constructor, enters an invoke
+       *
+       * \param event
+       *      Event being invoked
+       */
+      explicit InvokeScope(Event &event) : event(event)
+      {
+        ++event.invokeDepth_;
+      }
+
+      /*!
+       * \brief
+       *      Destructor, leaves the invoke
+       */
+      ~InvokeScope()
+      {
+        if (--event.invokeDepth_ == 0 && (event.removedCount_ || !event.pending_.empty()))
+          event.ApplyDeferred();
+      }
+
+      Event &event; //!< Event being invoked
+    };
+
+    /*!
+     * \brief
+     *      Invokes the callbacks, see Invoke
+     *
+     * \param args
+     *      Parameters to pass to each of the callback functions
+     */
+    template<typename ...Args>
+    void InvokeCallbacks(Args&&... args)
+    {
+      InvokeScope scope(*this);
+#ifdef EVENT_PROFILE
+      bool profile = ++profileInvokes_ % profileSampling_ == 0;
+#else
+      constexpr bool profile = false;
+#endif
+      if (onceCalls_)
+        return DispatchOnce(profile, std::forward<Args>(args)...);
+#ifdef EVENT_PROFILE
+      if (profile)
+        return DispatchProfiled(std::forward<Args>(args)...);
+#endif
+      if (moveToLast_)
+        DispatchMoveToLast(std::forward<Args>(args)...);
+      else
+        Dispatch(args...);
+    }
+
+#ifdef EVENT_COROUTINES
+    /*!
+     * \brief
+     *      Invokes the callbacks, then resumes the coroutines that were waiting on Next when
+     *      the invoke started. Each waiter copies the arguments first, a callback may move them.
+     *      The copy is made by the waiter so this never names _Payload, which events taking
+     *      abstract classes by reference cannot form. If a callback throws the waiters keep
+     *      waiting
+     *
+     * \param args
+     *      Parameters to pass to each of the callback functions and waiters
+     */
+    template<typename ...Args>
+    void InvokeAndResume(Args&&... args)
+    {
+      EventWaiters resumed(std::move(waiters_));
+      try
+      {
+        const typename signature_traits<FunctionSignature>::References arguments(args...);
+        for (EventWaiter *waiter = resumed.first; waiter; waiter = waiter->next)
+          waiter->capture(waiter, &arguments);
+        InvokeCallbacks(std::forward<Args>(args)...);
+      }
+      catch (...)
+      {
+        waiters_.Splice(resumed);
+        throw;
+      }
+
+      // The event may be destroyed by a resumed coroutine, only the local list is used from here
+      while (EventWaiter *waiter = resumed.first)
+      {
+        waiter->Unlink();
+        waiter->coroutine.resume();
+      }
+    }
+#endif
+
+    /*!
+     * \brief
+     *      Calls every callback in the call list without modifying the event
+     *
+     * \param args
+     *      Parameters to pass to each of the callback functions
+     */
+    template<typename ...Args>
+    void Dispatch(Args&... args) const
+    {
+      const _Function *functions = callList_.Functions();
+      const uint8_t *flags = callList_.Flags();
+      for (size_t i = 0, count = callList_.Size(); i < count; ++i)
+        if (!(flags[i] & CallList::Removed))
+          functions[i](args...);
+    }
+
+    /*!
+     * \brief
+     *      Calls every callback in the call list, unhooking the ones hooked by HookOnce as it
+     *      reaches them. The outermost invoke also moves the surviving calls down over the
+     *      removed ones as it goes and truncates the rest, so the list is compacted in the same
+     *      pass. Positions it has moved a call away from are marked removed, for nested invokes.
+     *      Moves into the last callback and profiles like the other dispatches
+     *
+     * \param profile
+     *      True to time each call into the profile of its slot, see EVENT_PROFILE
+     *
+     * \param args
+     *      Parameters to pass to each of the callback functions
+     */
+    template<typename ...Args>
+    void DispatchOnce([[maybe_unused]] bool profile, Args&&... args)
+    {
+      bool compact = invokeDepth_ == 1;
+      size_t size = callList_.Size();
+      size_t last = moveToLast_ ? size : 0;
+      while (last && callList_.IsRemoved(last - 1))
+        --last;
+
+      size_t write = 0;
+      for (size_t read = 0; read < size; ++read)
+      {
+        if (callList_.IsRemoved(read)) continue;
+
+        size_t index = read;
+        if (callList_.IsOnce(read))
+          RemoveOnce(read);
+        else if (compact)
+        {
+          if (write != read)
+          {
+            // Overwrites a removed call and leaves one behind, removedCount_ is unchanged
+            callList_.Move(write, read);
+            callList_.MarkRemoved(read, false);
+            slots_[GET_ID(callList_.Handle(write))].index = uint32_t(write);
+          }
+          index = write++;
+        }
+
+#ifdef EVENT_PROFILE
+        auto start = profile ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+#endif
+        if (read + 1 == last)
+          callList_.Callable(index)(std::forward<Args>(args)...);
+        else
+          callList_.Callable(index)(args...);
+#ifdef EVENT_PROFILE
+        if (profile) RecordProfile(callList_.Handle(index), start);
+#endif
+      }
+      if (!compact) return;
+
+      // Everything past the survivors is removed, calls hooked meanwhile follow the survivors
+      removedCount_ -= size - write;
+      callList_.Truncate(write);
+      onceCalls_ = 0;
+      for (size_t i = 0; i < pending_.size(); ++i)
+      {
+        if (pending_[i].removed) continue;
+        slots_[GET_ID(pending_[i].handle)].index = uint32_t(write + i);
+        onceCalls_ += pending_[i].once;
+      }
+    }
+
+    /*!
+     * \brief
+     *      Unhooks a call hooked by HookOnce that an invoke reached, keeping its callable alive
+     *      for the call about to be made
+     *
+     * \param index
+     *      Position of the call
+     */
+    void RemoveOnce(size_t index)
+    {
+      uint32_t id = uint32_t(GET_ID(callList_.Handle(index)));
+      Unlink(id);
+      FreeSlot(id);
+      MarkRemoved(index);
+    }
+
+    /*!
+     * \brief
+     *      Calls every callback in the call list, forwarding the arguments into the last one
+     *
+     * \param args
+     *      Parameters to pass to each of the callback functions
+     */
+    template<typename ...Args>
+    void DispatchMoveToLast(Args&&... args) const
+    {
+      size_t last = callList_.Size();
+      while (last && callList_.IsRemoved(last - 1))
+        --last;
+      if (!last) return;
+
+      for (size_t i = 0; i + 1 < last; ++i)
+        if (!callList_.IsRemoved(i))
+          callList_.Callable(i)(args...);
+      if (!callList_.IsRemoved(last - 1))
+        callList_.Callable(last - 1)(std::forward<Args>(args)...);
+    }
+
+#ifdef EVENT_PROFILE
+    /*!
+     * \brief
+     *      Calls every callback in the call list like Invoke, timing each call into the profile of its slot
+     *
+     * \param args
+     *      Parameters to pass to each of the callback functions
+     */
+    template<typename ...Args>
+    void DispatchProfiled(Args&&... args)
+    {
+      size_t last = callList_.Size();
+      if (moveToLast_)
+        while (last && callList_.IsRemoved(last - 1))
+          --last;
+
+      for (size_t i = 0; i < callList_.Size(); ++i)
+      {
+        if (callList_.IsRemoved(i)) continue;
+
+        auto start = std::chrono::steady_clock::now();
+        if (moveToLast_ && i + 1 == last)
+          callList_.Callable(i)(std::forward<Args>(args)...);
+        else
+          callList_.Callable(i)(args...);
+        RecordProfile(callList_.Handle(i), start);
+      }
+    }
+
+    /*!
+     * \brief
+     *      Records the time since a call started into the profile of its slot
+     *
+     * \param handle
+     *      Handle of the call
+     *
+     * \param start
+     *      Time the call started
+     */
+    void RecordProfile(EVENT_HANDLE handle, std::chrono::steady_clock::time_point start)
+    {
+      auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+      // The callback may have unhooked itself and its slot been reused, calls hooked by HookOnce always have
+      uint32_t id = uint32_t(GET_ID(handle));
+      if (slots_[id].generation == GET_GENERATION(handle))
+        profiles_[id].Record(uint64_t(ns));
+    }
+#endif
+
+    /*!
+     * \brief
+     *      Adds a call to the call list, or defers it while invoking
+     *
+     * \param call
+     *      Call to add
+     *
+     * \param key
+     *      Identity of the call
+     *
+     * \return
+     *      Returns the handle of the call
+     */
+    EVENT_HANDLE AddCall(_CallType &&call, const CallKey &key)
+    {
+      assert((Ordered || !key.Addressable() || !FindKey(key)) && "ERROR : Duplicate function hooked to event");
+
+      uint32_t id = AllocateSlot();
+#ifdef EVENT_PROFILE
+      profiles_.resize(slots_.size());
+      profiles_[id] = EventProfile();
+#endif
+      Slot &slot = slots_[id];
+      slot.index = uint32_t(callList_.Size() + pending_.size());
+      slot.key = key;
+      Link(id);
+
+      EVENT_HANDLE handle = GET_HANDLE(slot.generation, id);
+      call.handle = handle;
+      if (invokeDepth_)
+        pending_.emplace_back(std::move(call));
+      else
+        Insert(std::move(call));
+      return handle;
+    }
+
+    /*!
+     * \brief
+     *      Places a call in the call list after every call of the same or higher priority.
+     *      Appends in O(1) when that is the end, else binary searches the spot and moves the
+     *      rest of the list up one
+     *
+     * \param call
+     *      Call to insert, its slot index is updated if it is not appended
+     */
+    void Insert(_CallType &&call)
+    {
+      if (callList_.Empty() || callList_.Priority(callList_.Size() - 1) >= call.priority)
+      {
+        callList_.PushBack(std::move(call));
+        return;
+      }
+
+      size_t index = callList_.UpperBound(call.priority);
+      callList_.Insert(index, std::move(call));
+      Reindex(index);
+    }
+
+    /*!
+     * \brief
+     *      Points the slots of the calls from a position onward back at their calls
+     *
+     * \param first
+     *      Position of the first call that moved
+     */
+    void Reindex(size_t first)
+    {
+      for (size_t i = first; i < callList_.Size(); ++i)
+        if (!callList_.IsRemoved(i))
+          slots_[GET_ID(callList_.Handle(i))].index = uint32_t(i);
+    }
+
+    /*!
+     * \brief
+     *      Takes a slot from the free list, or grows the slot map
+     *
+     * \return
+     *      Returns the index of the slot
+     */
+    uint32_t AllocateSlot()
+    {
+      if (freeSlot_ != NoSlot)
+      {
+        uint32_t id = freeSlot_;
+        freeSlot_ = slots_[id].index;
+        return id;
+      }
+
+      assert(slots_.size() < NoSlot && "ERROR : Event slot map is full");
+      slots_.push_back({0, 1, NoSlot, NoSlot, CallKey()});
+      return uint32_t(slots_.size() - 1);
+    }
+
+    /*!
+     * \brief
+     *      Returns a slot to the free list, invalidating every handle to it.
+     *      A slot whose generation is exhausted is never reused
+     *
+     * \param id
+     *      Index of the slot
+     */
+    void FreeSlot(uint32_t id)
+    {
+      Slot &slot = slots_[id];
+      slot.key = CallKey();
+      if (++slot.generation > MaxGeneration) return;
+      slot.index = freeSlot_;
+      freeSlot_ = id;
+    }
+
+    /*!
+     * \brief
+     *      Adds a slot to the list of its class or cluster
+     *
+     * \param id
+     *      Index of the slot
+     */
+    void Link(uint32_t id)
+    {
+      Slot &slot = slots_[id];
+      slot.prev = slot.next = NoSlot;
+      std::uintptr_t list = ListKey(slot.key);
+      if (!list) return;
+
+      auto [head, added] = groups_.TryEmplace(list, id);
+      if (added) return;
+      slot.next = *head;
+      slots_[*head].prev = id;
+      *head = id;
+    }
+
+    /*!
+     * \brief
+     *      Removes a slot from the list of its class or cluster
+     *
+     * \param id
+     *      Index of the slot
+     */
+    void Unlink(uint32_t id)
+    {
+      Slot &slot = slots_[id];
+      std::uintptr_t list = ListKey(slot.key);
+      if (!list) return;
+
+      if (slot.next != NoSlot) slots_[slot.next].prev = slot.prev;
+      if (slot.prev != NoSlot)
+        slots_[slot.prev].next = slot.next;
+      else if (slot.next != NoSlot)
+        *groups_.Find(list) = slot.next;
+      else
+        groups_.Erase(list);
+    }
+
+    /*!
+     * \brief
+     *      Gets the slot a handle refers to
+     *
+     * \param handle
+     *      Handle to look up
+     *
+     * \return
+     *      Returns the slot, or nullptr if the handle is a cluster handle or stale
+     */
+    Slot* FindSlot(EVENT_HANDLE handle)
+    {
+      uint32_t id = uint32_t(GET_ID(handle));
+      if (GET_CLUSTER(handle) || id >= slots_.size() || slots_[id].generation != GET_GENERATION(handle))
+        return nullptr;
+      return &slots_[id];
+    }
+
+    /*!
+     * \brief
+     *      Finds the first call hooked with a key by walking the list of its class, cluster
+     *      or function, O(k) where k is the number of calls in that list
+     *
+     * \param key
+     *      Identity of the call
+     *
+     * \return
+     *      Returns the handle of the call, or 0 if not hooked
+     */
+    EVENT_HANDLE FindKey(const CallKey &key)
+    {
+      uint32_t *head = groups_.Find(ListKey(key));
+      uint32_t found = NoSlot;
+      for (uint32_t id = head ? *head : NoSlot; id != NoSlot; id = slots_[id].next)
+        if (slots_[id].key == key && (found == NoSlot || slots_[id].index < slots_[found].index))
+          found = id;
+      return found == NoSlot ? EVENT_HANDLE(0) : GET_HANDLE(slots_[found].generation, found);
+    }
+
+    /*!
+     * \brief
+     *      Gets the list a call is linked in. Calls of a class or cluster share its list,
+     *      non-member functions share one per function so they are found without scanning
+     *
+     * \param key
+     *      Identity of the call
+     *
+     * \return
+     *      Returns the class address, cluster handle or function address, or 0 for lambdas
+     */
+    static std::uintptr_t ListKey(const CallKey &key)
+    {
+      return key.group ? key.group : key.function[0];
+    }
+
+    /*!
+     * \brief
+     *      Marks a call as removed so invoke skips it. Positions past the call list mark the pending calls
+     *
+     * \param index
+     *      Position of the call
+     */
+    void MarkRemoved(size_t index)
+    {
+      if (index < callList_.Size())
+        callList_.MarkRemoved(index, !invokeDepth_);
+      else
+        pending_[index - callList_.Size()].removed = true;
+      ++removedCount_;
+    }
+
+    /*!
+     * \brief
+     *      Removes the call occupying a slot. Unordered lists move the last call into its place,
+     *      ordered lists and lists being invoked leave a removed call behind to be compacted
+     *
+     * \param id
+     *      Index of the slot
+     */
+    void RemoveSlot(uint32_t id)
+    {
+      size_t index = slots_[id].index;
+      FreeSlot(id);
+
+      if (invokeDepth_ || Ordered)
+        return MarkRemoved(index);
+
+      size_t last = callList_.Size() - 1;
+      if (index != last)
+      {
+        callList_.Move(index, last);
+        slots_[GET_ID(callList_.Handle(index))].index = uint32_t(index);
+      }
+      callList_.Truncate(last);
+    }
+
+    /*!
+     * \brief
+     *      Erases removed calls from the call list, keeping the order of the rest.
+     *      Deferred while invoking
+     *
+     * \param threshold
+     *      Only compacts if more than this share of the call list is removed, keeps unhooking amortized O(1)
+     */
+    void Compact(size_t threshold = 0)
+    {
+      if (invokeDepth_ || removedCount_ <= callList_.Size() * threshold / 4) return;
+
+      // Skips the live calls before the first removed one, then moves each run of live calls down
+      constexpr uint8_t Removed = CallList::Removed;
+      size_t size = callList_.Size();
+      size_t write = EventScan::Find(callList_.Flags(), 0, size, Removed, Removed);
+      size_t read = write;
+      while (read < size)
+      {
+        read = EventScan::Find(callList_.Flags(), read, size, Removed, 0);
+        size_t end = EventScan::Find(callList_.Flags(), read, size, Removed, Removed);
+        for (; read < end; ++read, ++write)
+        {
+          callList_.Move(write, read);
+          slots_[GET_ID(callList_.Handle(write))].index = uint32_t(write);
+        }
+      }
+      callList_.Truncate(write);
+      removedCount_ = 0;
+    }
+
+    /*!
+     * \brief
+     *      Adds the calls hooked during an invoke and erases the ones removed during it.
+     *      Called when the outermost invoke finishes
+     */
+    void ApplyDeferred()
+    {
+      size_t first = callList_.Size();
+      for (auto &call : pending_)
+        callList_.PushBack(std::move(call));
+      pending_.clear();
+
+      if (first && first < callList_.Size() && !callList_.SortedFrom(first - 1))
+      {
+        callList_.SortByPriority();
+        Reindex(0);
+      }
+      Compact();
+    }
+
+    /*!
+     * \brief
+     *      Unhooks a cluster handle or class address from the call list in O(k),
+     *      where k is the number of calls hooked with it
+     *
+     * \param group
+     *      Cluster handle or class address of the calls to unhook
+     */
+    void RemoveCluster(EVENT_HANDLE group)
+    {
+      uint32_t *head = groups_.Find(std::uintptr_t(group));
+      if (!head) return;
+
+      uint32_t id = *head;
+      groups_.Erase(std::uintptr_t(group));
+      while (id != NoSlot)
+      {
+        uint32_t next = slots_[id].next;
+        RemoveSlot(id);
+        id = next;
+      }
+      Compact(1);
+    }
+
+    /*!
+     * \brief
+     *      Unhooks a handle from the call list
+     *
+     * \param handle
+     *      Handle to the function to unhook
+     *
+     * \param compact
+     *      False when unhooking in bulk, the caller compacts once at the end
+     */
+    void RemoveCall(EVENT_HANDLE handle, bool compact = true)
+    {
+      if (!FindSlot(handle)) return;
+      Unlink(uint32_t(GET_ID(handle)));
+      RemoveSlot(uint32_t(GET_ID(handle)));
+      if (compact) Compact(1);
+    }
+
+    /*!
+     * \brief
+     *      Unhooks the first call hooked with a key
+     *
+     * \param key
+     *      Identity of the function to unhook
+     *
+     * \param compact
+     *      False when unhooking in bulk, the caller compacts once at the end
+     */
+    void RemoveKey(const CallKey &key, bool compact = true)
+    {
+      if (!key.Addressable()) return;
+      if (EVENT_HANDLE handle = FindKey(key)) RemoveCall(handle, compact);
+    }
+
+    /*!
+     * \brief
+     *      Makes room for the callbacks of a range about to be hooked, if its length is known
+     *      without walking it. Grows at least geometrically so repeated small ranges stay
+     *      amortized O(1) per callback
+     *
+     * \param first
+     *      Iterator to the first callback
+     *
+     * \param last
+     *      Iterator past the last callback
+     */
+    template<typename It>
+    void ReserveRange(It first, It last)
+    {
+      using Category = typename std::iterator_traits<It>::iterator_category;
+      if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>)
+      {
+        size_t count = callList_.Size() + pending_.size() + size_t(std::distance(first, last));
+        size_t capacity = invokeDepth_ ? callList_.Size() + pending_.capacity() : callList_.Capacity();
+        if (count > capacity)
+          Reserve(std::max(count, capacity * 2));
+      }
+    }
+
+    /*!
+     * \brief
+     *      Narrows a priority to the int32_t stored with each call
+     *
+     * \param priority
+     *      Integer or enumeration priority, asserted to be within the range of int32_t
+     *
+     * \return
+     *      Returns the priority as an int32_t
+     */
+    template<typename P>
+    static int32_t PriorityOf(P priority)
+    {
+      if constexpr (std::is_enum_v<P>)
+        return PriorityOf(static_cast<std::underlying_type_t<P>>(priority));
+      else
+      {
+        if constexpr (std::is_signed_v<P>)
+          assert(int64_t(priority) >= std::numeric_limits<int32_t>::min() && int64_t(priority) <= std::numeric_limits<int32_t>::max()
+                 && "ERROR : Priority outside the range of int32_t");
+        else
+          assert(uint64_t(priority) <= uint64_t(std::numeric_limits<int32_t>::max()) && "ERROR : Priority outside the range of int32_t");
+        return static_cast<int32_t>(priority);
+      }
+    }
+
+    //! Gets an object of a range hooked by HookRange
+    template<typename C>
+    static C& ObjectOf(C &object) { return object; }
+
+    //! Gets an object of a range of pointers hooked by HookRange
+    template<typename C>
+    static C& ObjectOf(C *object) { return *object; }
+
+    /*!
+     * \brief
+     *      Builds the key of a hooked function
+     *
+     * \tparam Fn
+     *      Type of function, member function or lambda
+     *
+     * \param group
+     *      Class address, cluster handle or 0 for non-member functions
+     *
+     * \param func_ptr
+     *      Function to build the key of
+     *
+     * \return
+     *      Returns the key, with no function bits for lambdas
+     */
+    template<typename Fn>
+    static CallKey MakeKey(std::uintptr_t group, const Fn &func_ptr)
+    {
+      using Pointer = std::decay_t<Fn>;
+      CallKey key;
+      key.group = group;
+      if constexpr (std::is_member_function_pointer_v<Pointer> || std::is_pointer_v<Pointer>)
+      {
+        static_assert(sizeof(Pointer) <= sizeof(key.function), "Function pointer larger than the key");
+        Pointer pointer = func_ptr;
+        std::memcpy(key.function, &pointer, sizeof(Pointer));
+      }
+      return key;
+    }
+
+    /*!
+     * \brief
+     *      Converts a pointer into an std::uintptr_t for the EVENT_HANDLE
+     *
+     * \tparam T
+     *      Type of pointer
+     *
+     * \param t
+     *      Pointer to hash
+     *
+     * \return
+     *      Returns the address of the pointer as an int
+     */
+    template<typename T>
+    static constexpr std::uintptr_t POINTER_INT_CAST(T t)
+    {
+        return reinterpret_cast<std::uintptr_t>(*reinterpret_cast<void**>(&t));
+    }
+
+    /*!
+     * \brief
+     *      Base case, not a member function of a class
+     */
+    template<typename, typename>
+    struct is_member_function_of
+    {
+      static constexpr bool value = false;
+    };
+
+    /*!
+     * \brief
+     *      Overload for non-static non-ellipsis member functions
+     */
+    #define DEF_IS_MEMBER_FUNCTION_OF(CV_REF_NOEXCEPT_OPT) \
+      template<typename C, typename R, typename... Args> \
+      struct is_member_function_of<C, R(C::*)(Args...) CV_REF_NOEXCEPT_OPT> \
+      { \
+          static constexpr bool value = true; \
+      }
+
+    /*!
+     * \brief
+     *     Overload for non-static ellipsis member functions
+     */
+    #define DEF_IS_MEMBER_FUNCTION_OF_ELLIPSIS(CV_REF_NOEXCEPT_OPT) \
+      template<typename C, typename R, typename... Args> \
+      struct is_member_function_of<C, R(C::*)(Args..., ...) CV_REF_NOEXCEPT_OPT> \
+      { \
+          static constexpr bool value = true; \
+      }
+
+    /*!
+     * \brief
+     *      Generates all overloads for member functions and their decorators
+     *
+     * \tparam C
+     *      Class type
+     *
+     * \tparam R
+     *      Return type
+     *
+     * \tparam Args
+     *      Argument type list
+     */
+    PERMUTE_PMF(DEF_IS_MEMBER_FUNCTION_OF);
+
+    /*!
+     * \brief
+     *      Base case, is a lambda, check if it can be constructed as an std::function
+     */
+    template<typename COMP, typename Fn>
+    struct parameter_equivalents
+    { static constexpr bool value = std::is_constructible_v<std::function<_Signature>, Fn>; };
+
+    /*!
+     * \brief
+     *     Non-member function overload to see if COMP can be invoked with arguments Args
+     *
+     * \tparam COMP
+     *     Function type to be invoked
+     *
+     * \tparam R
+     *     Return type of non-member function
+     *
+     * \tparam Args
+     *     Argument list of non-member function
+     */
+    template<typename COMP, typename R, typename ...Args>
+    struct parameter_equivalents<COMP, R(*)(Args...)>
+    { static constexpr bool value = std::is_invocable_v<COMP, Args...>; };
+
+    /*!
+     * \brief
+     *      Overload for non-static non-ellipsis member function
+     */
+    #define DEF_PARAMETER_EQUIVALENTS(CV_REF_NOEXCEPT_OPT) \
+    template<typename COMP, typename C, typename R, typename ...Args> \
+    struct parameter_equivalents<COMP, R(C::*)(Args...) CV_REF_NOEXCEPT_OPT> \
+    { static constexpr bool value = std::is_invocable_v<COMP, Args...>; };
+
+    /*!
+     * \brief
+     *      Overload for non-static ellipsis member function
+     */
+    #define DEF_PARAMETER_EQUIVALENTS_ELLIPSIS(CV_REF_NOEXCEPT_OPT) \
+    template<typename COMP, typename C, typename R, typename ...Args> \
+    struct parameter_equivalents<COMP, R(C::*)(Args..., ...) CV_REF_NOEXCEPT_OPT> \
+    { static constexpr bool value = std::is_invocable_v<COMP, Args...>; };
+
+    /*!
+     * \brief
+     *      Generates all overloads to check if COMP can be invoked with
+     *      the arguments of Args
+     *
+     * \tparam COMP
+     *      Function signature to be invoked with arguments Args
+     *
+     * \tparam C
+     *      Type of class
+     *
+     * \tparam R
+     *      Return type
+     *
+     * \tparam Args
+     *      List of argument types
+     */
+    PERMUTE_PMF(DEF_PARAMETER_EQUIVALENTS);
+};
+
+/*!
+ * \brief
+ *      Base class that unhooks an object from every event it listens to when it is destroyed,
+ *      so an object that dies without calling UnhookClass is never invoked. Subscriptions are
+ *      kept in intrusive lists shared with the events, costing O(subscriptions) at teardown and
+ *      nothing on invoke. An event destroyed first drops its subscriptions
+ *      NOTE: Copies and moves of a listener start with no subscriptions, the callbacks stay
+ *            bound to the original object
+ */
+class EventListener
+{
+  public:
+    /*!
+     * \brief
+     *      Default Constructor
+     */
+    EventListener() = default;
+
+    //! Copies start with no subscriptions
+    EventListener(const EventListener&) noexcept {}
+
+    //! Keeps the subscriptions, they belong to this object
+    EventListener& operator=(const EventListener&) noexcept { return *this; }
+
+    /*!
+     * \brief
+     *      Destructor, unhooks every subscription
+     */
+    ~EventListener()
+    {
+      UnhookAll();
+    }
+
+    /*!
+     * \brief
+     *      Hooks a non-static member function of this object to an event and tracks it
+     *
+     * \tparam C
+     *      Type of the object, derived from EventListener
+     *
+     * \tparam Fn
+     *      Type of non-static member function
+     *
+     * \param event
+     *      Event to hook to
+     *
+     * \param func_ptr
+     *      Pointer to non-static member function of C to hook
+     *
+     * \return
+     *      Returns the handle of the call
+     */
+    template<typename FunctionSignature, bool KeepOrder, typename Allocator, typename Function, typename Fn>
+    EVENT_HANDLE Listen(Event<FunctionSignature, KeepOrder, Allocator, Function> &event, Fn func_ptr)
+    {
+      using C = typename member_class<Fn>::type;
+      static_assert(std::is_base_of_v<EventListener, C>, "Listen hooks methods of the listener's own class");
+      return Track(event, event.Hook(static_cast<C&>(*this), func_ptr));
+    }
+
+    /*!
+     * \brief
+     *      Tracks a call already hooked to an event, such as a lambda capturing this object,
+     *      so it is unhooked with the listener
+     *
+     * \param event
+     *      Event the call is hooked to
+     *
+     * \param handle
+     *      Handle of the call
+     *
+     * \return
+     *      Returns the handle
+     */
+    template<typename FunctionSignature, bool KeepOrder, typename Allocator, typename Function>
+    EVENT_HANDLE Track(Event<FunctionSignature, KeepOrder, Allocator, Function> &event, EVENT_HANDLE handle)
+    {
+      using EventType = Event<FunctionSignature, KeepOrder, Allocator, Function>;
+      EventSubscriptions &owner = event;
+
+      void *memory = EventPool::Default().Allocate(sizeof(EventSubscription), alignof(EventSubscription));
+      EventSubscription *subscription = new (memory) EventSubscription{ &owner, &UnhookFrom<EventType>, handle,
+                                                                         &subscriptions_, nullptr, subscriptions_,
+                                                                         nullptr, owner.firstSubscription };
+      if (subscriptions_) subscriptions_->listenerPrev = subscription;
+      subscriptions_ = subscription;
+      if (owner.firstSubscription) owner.firstSubscription->eventPrev = subscription;
+      owner.firstSubscription = subscription;
+      return handle;
+    }
+
+    /*!
+     * \brief
+     *      Unhooks every call this listener tracks
+     */
+    void UnhookAll()
+    {
+      while (EventSubscription *subscription = subscriptions_)
+      {
+        subscriptions_ = subscription->listenerNext;
+        EventSubscriptions::UnlinkEvent(subscription);
+        subscription->unhook(subscription->owner, subscription->handle);
+        EventSubscriptions::Free(subscription);
+      }
+    }
+
+    /*!
+     * \brief
+     *      Getter for the number of calls this listener tracks
+     *
+     * \return
+     *      Returns the number of subscriptions, ones already unhooked by handle included
+     */
+    [[nodiscard]] size_t SubscriptionCount() const
+    {
+      size_t count = 0;
+      for (const EventSubscription *subscription = subscriptions_; subscription; subscription = subscription->listenerNext)
+        ++count;
+      return count;
+    }
+
+  private:
+    EventSubscription *subscriptions_ = nullptr; //!< First subscription
+
+    //! Gets the class of a pointer to member function
+    template<typename Fn>
+    struct member_class;
+
+    template<typename C, typename M>
+    struct member_class<M C::*> { using type = C; };
+
+    /*!
+     * \brief
+     *      Unhooks a handle from the event owning a subscription list
+     *
+     * \tparam EventType
+     *      Type of the event
+     *
+     * \param owner
+     *      Subscriptions of the event
+     *
+     * \param handle
+     *      Handle to unhook
+     */
+    template<typename EventType>
+    static void UnhookFrom(EventSubscriptions *owner, EVENT_HANDLE handle)
+    {
+      static_cast<EventType*>(owner)->Unhook(handle);
+    }
+};
+
+/*!
+ * \brief
+ *      Collector keeping the result of the first callback, stopping the invoke there
+ *
+ * \tparam T
+ *      Result type
+ */
+template<typename T>
+struct CollectFirst
+{
+  /*!
+   * \brief
+   *      Takes a result
+   *
+   * \param result
+   *      Result of a callback
+   *
+   * \return
+   *      Returns false, no more results are needed
+   */
+  template<typename U>
+  bool operator()(U &&result)
+  {
+    value = std::forward<U>(result);
+    ++count;
+    return false;
+  }
+
+  T value{};        //!< First result
+  size_t count = 0; //!< Results taken, 0 if no callback ran
+};
+
+/*!
+ * \brief
+ *      Collector keeping the result of the last callback
+ *
+ * \tparam T
+ *      Result type
+ */
+template<typename T>
+struct CollectLast
+{
+  /*!
+   * \brief
+   *      Takes a result
+   *
+   * \param result
+   *      Result of a callback
+   *
+   * \return
+   *      Returns true, every result is needed
+   */
+  template<typename U>
+  bool operator()(U &&result)
+  {
+    value = std::forward<U>(result);
+    ++count;
+    return true;
+  }
+
+  T value{};        //!< Last result
+  size_t count = 0; //!< Results taken, 0 if no callback ran
+};
+
+/*!
+ * \brief
+ *      Collector checking if any callback returned true, stopping the invoke at the first one
+ */
+struct CollectAnyTrue
+{
+  /*!
+   * \brief
+   *      Takes a result
+   *
+   * \param result
+   *      Result of a callback
+   *
+   * \return
+   *      Returns false once a result was true
+   */
+  template<typename U>
+  bool operator()(U &&result)
+  {
+    value = bool(result);
+    return !value;
+  }
+
+  bool value = false; //!< True if a callback returned true
+};
+
+/*!
+ * \brief
+ *      Collector adding up the results of every callback
+ *
+ * \tparam T
+ *      Result type
+ */
+template<typename T>
+struct CollectSum
+{
+  /*!
+   * \brief
+   *      Constructor
+   *
+   * \param init
+   *      Value the results are added to
+   */
+  explicit CollectSum(T init = T()) : value(std::move(init))
+  {}
+
+  /*!
+   * \brief
+   *      Takes a result
+   *
+   * \param result
+   *      Result of a callback
+   *
+   * \return
+   *      Returns true, every result is needed
+   */
+  template<typename U>
+  bool operator()(U &&result)
+  {
+    value += std::forward<U>(result);
+    return true;
+  }
+
+  T value; //!< Sum of the results
+};
+
+/*!
+ * \brief
+ *      Collector keeping the smallest result of every callback
+ *
+ * \tparam T
+ *      Result type
+ */
+template<typename T>
+struct CollectMin
+{
+  /*!
+   * \brief
+   *      Takes a result
+   *
+   * \param result
+   *      Result of a callback
+   *
+   * \return
+   *      Returns true, every result is needed
+   */
+  template<typename U>
+  bool operator()(U &&result)
+  {
+    if (!count++ || result < value)
+      value = std::forward<U>(result);
+    return true;
+  }
+
+  T value{};        //!< Smallest result
+  size_t count = 0; //!< Results taken, 0 if no callback ran
+};
+
+/*!
+ * \brief
+ *      Collector keeping the largest result of every callback
+ *
+ * \tparam T
+ *      Result type
+ */
+template<typename T>
+struct CollectMax
+{
+  /*!
+   * \brief
+   *      Takes a result
+   *
+   * \param result
+   *      Result of a callback
+   *
+   * \return
+   *      Returns true, every result is needed
+   */
+  template<typename U>
+  bool operator()(U &&result)
+  {
+    if (!count++ || value < result)
+      value = std::forward<U>(result);
+    return true;
+  }
+
+  T value{};        //!< Largest result
+  size_t count = 0; //!< Results taken, 0 if no callback ran
+};
+
+/*!
+ * \brief
+ *      Base case, binds a non-static member function to an object with static storage duration
+ */
+template<auto Method, auto *Object, typename = decltype(Method)>
+struct method_binding;
+
+/*!
+ * \brief
+ *      Overload for non-static non-ellipsis member functions
+ */
+#define DEF_METHOD_BINDING(CV_REF_NOEXCEPT_OPT) \
+  template<auto Method, auto *Object, typename C, typename R, typename ...Args> \
+  struct method_binding<Method, Object, R(C::*)(Args...) CV_REF_NOEXCEPT_OPT> \
+  { static R Call(Args... args) { return std::invoke(Method, Object, std::forward<Args>(args)...); } }
+
+/*!
+ * \brief
+ *      Overload for non-static ellipsis member functions
+ */
+#define DEF_METHOD_BINDING_ELLIPSIS(CV_REF_NOEXCEPT_OPT) \
+  template<auto Method, auto *Object, typename C, typename R, typename ...Args> \
+  struct method_binding<Method, Object, R(C::*)(Args..., ...) CV_REF_NOEXCEPT_OPT> \
+  { static R Call(Args... args) { return std::invoke(Method, Object, std::forward<Args>(args)...); } }
+
+/*!
+ * \brief
+ *      Generates all overloads binding a member function and its decorators to an object
+ *
+ * \tparam Method
+ *      Pointer to non-static member function
+ *
+ * \tparam Object
+ *      Pointer to the object the method is called on
+ */
+PERMUTE_PMF(DEF_METHOD_BINDING);
+
+/*!
+ * \brief
+ *      Non-member function that calls the non-static member function 'Method' on 'Object'.
+ *      Used to hook methods to a StaticEvent, ex. StaticMethod<&Object::method, &object>
+ *
+ * \tparam Method
+ *      Pointer to non-static member function
+ *
+ * \tparam Object
+ *      Pointer to an object with static storage duration
+ */
+template<auto Method, auto *Object>
+constexpr auto StaticMethod = &method_binding<Method, Object>::Call;
+
+/*!
+ * \brief
+ *      Event whose callbacks are bound at compile time. Holds no call list, invoking it
+ *      is a sequence of direct calls the compiler is free to inline
+ *
+ * \tparam FunctionSignature
+ *      Function signature of the callbacks
+ *      NOTE: All callbacks must be of this type
+ *
+ * \tparam Callbacks
+ *      Pointers to non-member functions, static member functions or StaticMethod bindings.
+ *      Invoked in the order they are listed
+ */
+template<typename FunctionSignature, auto ...Callbacks>
+class StaticEvent
+{
+    using Checks = Event<FunctionSignature>; //!< Event providing the signature checks
+
+    static_assert(!(... || std::is_member_function_pointer_v<decltype(Callbacks)>),
+                  "A callback in variadic list Callbacks... is a class member, bind it with StaticMethod<&C::method, &object>");
+    static_assert(Checks::template is_same_arg_list<decltype(Callbacks)...>());
+
+  public:
+    using _Signature = FunctionSignature; //!< Function Signature
+
+    /*!
+     * \brief
+     *      Invokes each callback bound to the event, in the order they are listed
+     *
+     * \tparam Args
+     *      Types of the parameters passed in
+     *
+     * \param args
+     *      Parameters to pass to each of the callback functions
+     *      NOTE: Must be the same arguments as the FUNCTION_SIGNATURE
+     */
+    template<typename ...Args>
+    static void Invoke(Args&&... args)
+    VERIFY_TYPE(Checks::template invocable<Args...>())
+    {
+      ((void)Callbacks(args...), ...);
+    }
+
+    /*!
+     * \brief
+     *      Getter for how many callbacks are bound to this event
+     *
+     * \return
+     *      Returns number of callbacks bound to this event
+     */
+    [[nodiscard]] static constexpr size_t CallListSize()
+    {
+      return sizeof...(Callbacks);
+    }
+};
+
+/*!
+ * \brief
+ *      Maximum number of threads that may be inside a ConcurrentEvent invoke at once.
+ *      Further threads wait for one of them to leave. Threads that are alive but not
+ *      invoking do not count against the limit
+ */
+#ifndef EVENT_EPOCH_MAX_THREADS
+#define EVENT_EPOCH_MAX_THREADS 128
+#endif
+
+/*!
+ * \brief
+ *      Process wide epoch used to reclaim ConcurrentEvent snapshots. Readers publish the
+ *      epoch they entered at in a slot held for the outermost read section, a retired
+ *      snapshot is freed once every reader that could have seen it has left
+ */
+class EventEpoch
+{
+    static constexpr uint64_t Idle = std::numeric_limits<uint64_t>::max(); //!< Slot value of a thread outside any read
+
+    /*!
+     * \brief
+     *      Reader state, padded to its own cache line
+     */
+    struct alignas(64) Slot
+    {
+      std::atomic<uint64_t> epoch{Idle};    //!< Epoch the reader entered at, Idle if not reading
+      std::atomic<uint64_t> reads{0};       //!< Read sections entered, written only by the owner
+      std::atomic<bool>     claimed{false}; //!< True while a thread is inside a read section
+    };
+
+    /*!
+     * \brief
+     *      Thread local reader state
+     */
+    struct Local
+    {
+      Slot *slot = nullptr; //!< Slot claimed by the outermost read section, null outside one
+      size_t last = 0;      //!< Index of the last slot claimed, tried first by the next claim
+      size_t depth = 0;     //!< Nesting of read sections
+    };
+
+  public:
+    static constexpr size_t MaxThreads = EVENT_EPOCH_MAX_THREADS; //!< Number of reader slots
+
+    /*!
+     * \brief
+     *      Read side critical section. Snapshots loaded while a guard is alive are not freed
+     *      NOTE: Nests, only the outermost guard claims and releases a slot
+     */
+    class Guard
+    {
+      public:
+        /*!
+         * \brief
+         *      Constructor, enters the current epoch
+         */
+        Guard() : local_(Thread())
+        {
+          if (local_.depth++ == 0)
+          {
+            local_.slot = Claim(local_.last);
+            local_.slot->epoch.store(global_.load());
+          }
+          Slot &slot = *local_.slot;
+          slot.reads.store(slot.reads.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        /*!
+         * \brief
+         *      Destructor, leaves the epoch and releases the slot when outermost
+         */
+        ~Guard()
+        {
+          if (--local_.depth != 0) return;
+          local_.slot->epoch.store(Idle, std::memory_order_release);
+          local_.slot->claimed.store(false, std::memory_order_release);
+          local_.slot = nullptr;
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+      private:
+        Local &local_; //!< State of the calling thread
+    };
+
+    /*!
+     * \brief
+     *      Advances the global epoch. Call after unpublishing an object
+     *
+     * \return
+     *      Returns the epoch to retire the unpublished object with
+     */
+    static uint64_t Advance()
+    {
+      return global_.fetch_add(1);
+    }
+
+    /*!
+     * \brief
+     *      Checks if an object retired at 'epoch' can be freed
+     *
+     * \param epoch
+     *      Epoch returned by Advance when the object was retired
+     *
+     * \return
+     *      Returns true if no reader that entered at or before 'epoch' is still reading
+     */
+    static bool Quiescent(uint64_t epoch)
+    {
+      for (size_t i = 0, used = used_.load(); i < used; ++i)
+        if (slots_[i].epoch.load() <= epoch)
+          return false;
+      return true;
+    }
+
+    /*!
+     * \brief
+     *      Getter for the read sections entered by every thread
+     *
+     * \return
+     *      Returns the total number of read sections entered, including nested ones
+     */
+    [[nodiscard]] static uint64_t Reads()
+    {
+      uint64_t reads = 0;
+      for (size_t i = 0, used = used_.load(std::memory_order_acquire); i < used; ++i)
+        reads += slots_[i].reads.load(std::memory_order_relaxed);
+      return reads;
+    }
+
+  private:
+    static Slot slots_[MaxThreads];         //!< Reader slots
+    static std::atomic<size_t> used_;       //!< Slots ever claimed, bounds the reclaim scan
+    static std::atomic<uint64_t> global_;   //!< Global epoch
+
+    /*!
+     * \brief
+     *      Gets the reader state of the calling thread
+     *
+     * \return
+     *      Returns the thread local state
+     */
+    static Local& Thread()
+    {
+      thread_local Local local;
+      return local;
+    }
+
+    /*!
+     * \brief
+     *      Claims a free slot for the calling thread, waiting while MaxThreads threads are
+     *      inside a read section
+     *
+     * \param last
+     *      Index of the slot the thread claimed last, tried first so a thread keeps its cache
+     *      line. Set to the index of the claimed slot
+     *
+     * \return
+     *      Returns the claimed slot
+     */
+    static Slot* Claim(size_t &last)
+    {
+      for (;;)
+      {
+        for (size_t n = 0; n < MaxThreads; ++n)
+        {
+          size_t i = (last + n) % MaxThreads;
+          bool expected = false;
+          if (slots_[i].claimed.load(std::memory_order_relaxed)
+              || !slots_[i].claimed.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            continue;
+
+          for (size_t used = used_.load(); used < i + 1 && !used_.compare_exchange_weak(used, i + 1);) {}
+          last = i;
+          return &slots_[i];
+        }
+        std::this_thread::yield();
+      }
+    }
+};
+
+inline EventEpoch::Slot EventEpoch::slots_[EventEpoch::MaxThreads];
+inline std::atomic<size_t> EventEpoch::used_{0};
+inline std::atomic<uint64_t> EventEpoch::global_{0};
+
+/*!
+ * \brief
+ *      Counters describing the cost of a ConcurrentEvent
+ */
+struct ConcurrentEventStats
+{
+  uint64_t reads = 0;            //!< Read sections entered by every thread on any concurrent event
+  uint64_t publishes = 0;        //!< Snapshots published by this event
+  uint64_t writerContention = 0; //!< Writers that found another writer publishing and had to wait
+  uint64_t deferred = 0;         //!< Reclaim attempts that found a reader still inside an older snapshot
+  uint64_t reclaimed = 0;        //!< Snapshots freed
+  uint64_t pending = 0;          //!< Snapshots retired but not yet freed
+};
+
+/*!
+ * \brief
+ *      Event that may be invoked from any number of threads while others hook and unhook.
+ *      Invoke reads an immutable snapshot of the call list without locking, Hook and Unhook
+ *      copy the snapshot, modify the copy and publish it. Old snapshots are freed once no
+ *      reader can still see them
+ *
+ * \tparam FunctionSignature
+ *      Function signature of the callbacks to hold
+ *
+ * \tparam KeepOrder
+ *      Tells the system to invoke callbacks in the same order as they were hooked
+ *
+ * \tparam Allocator
+ *      Allocator for the call list of each snapshot
+ *
+ * \tparam Function
+ *      Type erased callable each callback is stored in
+ */
+template<typename FunctionSignature, bool KeepOrder = true, typename Allocator = std::allocator<Call<FunctionSignature>>,
+         typename Function = Delegate<FunctionSignature>>
+class ConcurrentEvent
+{
+    using EventType = Event<FunctionSignature, KeepOrder, Allocator, Function>; //!< Type of a snapshot
+
+  public:
+    using _Signature = FunctionSignature;              //!< Function Signature
+    using _Allocator = Allocator;                      //!< Event allocator
+    using _Function  = Function;                       //!< Type erased callable
+    using _CallType  = typename EventType::_CallType;  //!< Type of the call wrapper
+    static constexpr bool Ordered = KeepOrder;         //!< State of ordering
+
+    /*!
+     * \brief
+     *      Default Constructor, publishes an empty snapshot
+     */
+    ConcurrentEvent() : current_(new EventType)
+    {}
+
+    ConcurrentEvent(const ConcurrentEvent&) = delete;
+    ConcurrentEvent& operator=(const ConcurrentEvent&) = delete;
+
+    /*!
+     * \brief
+     *      Destructor, frees every snapshot
+     *      NOTE: No thread may be invoking the event
+     */
+    ~ConcurrentEvent()
+    {
+      for (auto &retired : retired_)
+        delete retired.snapshot;
+      delete current_.load(std::memory_order_relaxed);
+    }
+
+    /*!
+     * \brief
+     *      Hooks a function, lambda or method, see Event::Hook
+     *
+     * \return
+     *      Returns a handle corresponding to the hooked function
+     */
+    template<typename ...Ts>
+    EVENT_HANDLE Hook(Ts&&... ts)
+    {
+      return Publish([&](EventType &next) { return next.Hook(std::forward<Ts>(ts)...); });
+    }
+
+    /*!
+     * \brief
+     *      Hooks a cluster of non-member functions, see Event::HookFunctionCluster
+     *
+     * \return
+     *      Returns handle to corresponding to the cluster of non-member functions
+     */
+    template<typename ...Fns>
+    [[nodiscard]] EVENT_HANDLE HookFunctionCluster(Fns&&... func_ptrs)
+    {
+      return Publish([&](EventType &next) { return next.HookFunctionCluster(std::forward<Fns>(func_ptrs)...); });
+    }
+
+    /*!
+     * \brief
+     *      Hooks a cluster of non-static member functions, see Event::HookMethodCluster
+     *
+     * \return
+     *      Returns handle to corresponding to the cluster of non-static member functions
+     */
+    template<typename C, typename ...Fns>
+    [[nodiscard]] EVENT_HANDLE HookMethodCluster(C &class_ref, Fns... func_ptrs)
+    {
+      return Publish([&](EventType &next) { return next.HookMethodCluster(class_ref, func_ptrs...); });
+    }
+
+    /*!
+     * \brief
+     *      Invokes the callbacks of the current snapshot without locking
+     *      NOTE: Hooking or Unhooking during the invoke process, from any thread, takes
+     *            effect on the next invoke
+     *
+     * \param args
+     *      Parameters to pass to each of the callback functions
+     */
+    template<typename ...Args>
+    void Invoke(Args&&... args) const
+    VERIFY_TYPE(EventType::template invocable<Args...>())
+    {
+      EventEpoch::Guard guard;
+      current_.load()->Dispatch(args...);
+    }
+
+    /*!
+     * \brief
+     *      Unhooks a function, method or handle, see Event::Unhook
+     */
+    template<typename ...Ts>
+    void Unhook(Ts&&... ts)
+    {
+      Publish([&](EventType &next) { next.Unhook(std::forward<Ts>(ts)...); });
+    }
+
+    /*!
+     * \brief
+     *      Unhooks the cluster of functions corresponding to the handle
+     *
+     * \param handle
+     *      Handle corresponding to the cluster
+     */
+    void UnhookCluster(EVENT_HANDLE handle)
+    {
+      Publish([&](EventType &next) { next.UnhookCluster(handle); });
+    }
+
+    /*!
+     * \brief
+     *      Unhooks all non-static member functions hooked with the user defined type
+     *
+     * \param class_ref
+     *      Reference to class has non-static member functions hooked to event
+     */
+    template<typename C>
+    void UnhookClass(C &class_ref)
+    {
+      Publish([&](EventType &next) { next.UnhookClass(class_ref); });
+    }
+
+    /*!
+     * \brief
+     *      Unhooks a list of non-member functions with a single publish
+     *
+     * \param func_ptrs
+     *      List of non-member functions to unhook from event
+     */
+    template<typename ...Fns>
+    void UnhookFunctions(Fns ...func_ptrs)
+    {
+      Publish([&](EventType &next) { next.UnhookFunctions(func_ptrs...); });
+    }
+
+    /*!
+     * \brief
+     *      Unhooks a list of non-static member functions with a single publish
+     *
+     * \param class_ref
+     *      Reference to class that contains the non-static member functions
+     *
+     * \param func_ptrs
+     *      List of non-static member functions contained in class C to unhook from event
+     */
+    template<typename C, typename ...Fns>
+    void UnhookMethods(C &class_ref, Fns ...func_ptrs)
+    {
+      Publish([&](EventType &next) { next.UnhookMethods(class_ref, func_ptrs...); });
+    }
+
+    /*!
+     * \brief
+     *      Hooks every callback, or a method of every object, in a range with a single publish,
+     *      see Event::HookRange
+     */
+    template<typename ...Ts>
+    auto HookRange(Ts&&... ts)
+    {
+      return Publish([&](EventType &next) { return next.HookRange(std::forward<Ts>(ts)...); });
+    }
+
+    /*!
+     * \brief
+     *      Unhooks every handle in a range with a single publish
+     *
+     * \param first
+     *      Iterator to the first handle
+     *
+     * \param last
+     *      Iterator past the last handle
+     */
+    template<typename It>
+    void UnhookRange(It first, It last)
+    {
+      Publish([&](EventType &next) { next.UnhookRange(first, last); });
+    }
+
+    /*!
+     * \brief
+     *      Getter for how many callbacks are in the current snapshot
+     *
+     * \return
+     *      Returns number of callbacks hooked to this event
+     */
+    [[nodiscard]] size_t CallListSize() const
+    {
+      EventEpoch::Guard guard;
+      return current_.load()->CallListSize();
+    }
+
+    /*!
+     * \brief
+     *      Publishes an empty call list
+     */
+    void Clear()
+    {
+      Publish([](EventType &next) { next.Clear(); });
+    }
+
+    /*!
+     * \brief
+     *      Frees every retired snapshot no reader can still see
+     */
+    void Reclaim()
+    {
+      std::lock_guard<std::mutex> lock(writer_);
+      Collect();
+    }
+
+    /*!
+     * \brief
+     *      Getter for the counters of this event
+     *
+     * \return
+     *      Returns a copy of the counters
+     */
+    [[nodiscard]] ConcurrentEventStats Stats() const
+    {
+      ConcurrentEventStats stats;
+      stats.reads = EventEpoch::Reads();
+      stats.publishes = publishes_.load(std::memory_order_relaxed);
+      stats.writerContention = writerContention_.load(std::memory_order_relaxed);
+      stats.deferred = deferred_.load(std::memory_order_relaxed);
+      stats.reclaimed = reclaimed_.load(std::memory_order_relaxed);
+      stats.pending = pending_.load(std::memory_order_relaxed);
+      return stats;
+    }
+
+  private:
+    /*!
+     * \brief
+     *      Snapshot waiting for its readers to leave
+     */
+    struct Retired
+    {
+      const EventType *snapshot; //!< Unpublished snapshot
+      uint64_t epoch;            //!< Epoch the snapshot was retired at
+    };
+
+    std::atomic<const EventType*> current_;       //!< Published snapshot
+    std::mutex writer_;                           //!< Serializes writers
+    std::vector<Retired> retired_;                //!< Snapshots waiting to be freed, guarded by writer_
+    std::atomic<uint64_t> publishes_{0};          //!< Snapshots published
+    std::atomic<uint64_t> writerContention_{0};   //!< Writers that had to wait for the writer lock
+    std::atomic<uint64_t> deferred_{0};           //!< Reclaim attempts blocked by a reader
+    std::atomic<uint64_t> reclaimed_{0};          //!< Snapshots freed
+    std::atomic<uint64_t> pending_{0};            //!< Snapshots retired but not yet freed
+
+    /*!
+     * \brief
+     *      Copies the current snapshot, applies 'mutation' to the copy and publishes it
+     *
+     * \param mutation
+     *      Modification to apply to the copy
+     *
+     * \return
+     *      Returns the result of the mutation
+     */
+    template<typename Mutation>
+    decltype(auto) Publish(Mutation &&mutation)
+    {
+      std::unique_lock<std::mutex> lock(writer_, std::try_to_lock);
+      if (!lock.owns_lock())
+      {
+        writerContention_.fetch_add(1, std::memory_order_relaxed);
+        lock.lock();
+      }
+
+      auto next = std::make_unique<EventType>(*current_.load(std::memory_order_relaxed));
+      if constexpr (std::is_void_v<decltype(mutation(*next))>)
+      {
+        mutation(*next);
+        Swap(next.release());
+      }
+      else
+      {
+        auto result = mutation(*next);
+        Swap(next.release());
+        return result;
+      }
+    }
+
+    /*!
+     * \brief
+     *      Publishes a snapshot and retires the previous one
+     *      NOTE: writer_ must be held
+     *
+     * \param next
+     *      Snapshot to publish
+     */
+    void Swap(const EventType *next)
+    {
+      retired_.push_back({current_.exchange(next), EventEpoch::Advance()});
+      publishes_.fetch_add(1, std::memory_order_relaxed);
+      Collect();
+    }
+
+    /*!
+     * \brief
+     *      Frees retired snapshots no reader can still see
+     *      NOTE: writer_ must be held
+     */
+    void Collect()
+    {
+      auto live = std::remove_if(retired_.begin(), retired_.end(), [this](const Retired &retired)
+      {
+        if (!EventEpoch::Quiescent(retired.epoch)) return false;
+        delete retired.snapshot;
+        reclaimed_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      });
+      if (live != retired_.begin()) deferred_.fetch_add(1, std::memory_order_relaxed);
+      retired_.erase(live, retired_.end());
+      pending_.store(retired_.size(), std::memory_order_relaxed);
+    }
+};
+
+/*!
+ * \brief
+ *      Event that queues its arguments to invoke the callbacks later, at a well defined point.
+ *      Queued arguments are stored in a ring buffer that grows as needed and is reused, so
+ *      enqueueing does not allocate once the buffer holds the usual queue depth
+ *
+ * \tparam FunctionSignature
+ *      Function signature of the callbacks to hold
+ *
+ * \tparam KeepOrder
+ *      Tells the system to invoke callbacks in the same order as they were hooked
+ *
+ * \tparam Allocator
+ *      Allocator for the call list and the ring buffer
+ *
+ * \tparam Function
+ *      Type erased callable each callback is stored in
+ */
+template<typename FunctionSignature, bool KeepOrder = true, typename Allocator = std::allocator<Call<FunctionSignature>>,
+         typename Function = Delegate<FunctionSignature>>
+class EventQueue : public Event<FunctionSignature, KeepOrder, Allocator, Function>
+{
+  public:
+    using _Payload = typename signature_traits<FunctionSignature>::Payload; //!< Arguments stored per queued invoke
+
+    /*!
+     * \brief
+     *      Default Constructor
+     */
+    EventQueue() = default;
+
+    EventQueue(const EventQueue&) = delete;
+    EventQueue& operator=(const EventQueue&) = delete;
+
+    /*!
+     * \brief
+     *      Destructor, discards the queued arguments
+     */
+    ~EventQueue()
+    {
+      ClearQueue();
+      if (buffer_) PayloadTraits::deallocate(allocator_, buffer_, capacity_);
+    }
+
+    /*!
+     * \brief
+     *      Queues an invoke, to be carried out by Dispatch
+     *
+     * \tparam Args
+     *      Types of the parameters passed in
+     *
+     * \param args
+     *      Parameters to pass to each of the callback functions
+     *      NOTE: Must be the same arguments as the FUNCTION_SIGNATURE
+     */
+    template<typename ...Args>
+    void Enqueue(Args&&... args)
+    {
+      static_assert(std::is_constructible_v<_Payload, Args&&...>, "Attempting to enqueue event with differing arguments then the event function signature");
+      if (size_ == capacity_) Grow(capacity_ ? capacity_ * 2 : 16);
+      PayloadTraits::construct(allocator_, buffer_ + ((head_ + size_) & (capacity_ - 1)), std::forward<Args>(args)...);
+      ++size_;
+    }
+
+    /*!
+     * \brief
+     *      Invokes every callback once for each invoke queued before the call, as one
+     *      InvokeBatch: callbacks are the outer loop and the queued invokes the inner one.
+     *      Invokes queued by the callbacks are left for the next dispatch, and so are
+     *      callbacks hooked by them. Falls back to one Invoke per queued invoke while
+     *      coroutines wait on Next, or if the signature takes non-const references
+     *
+     * \return
+     *      Returns the number of queued invokes carried out
+     */
+    size_t Dispatch()
+    {
+      size_t count = size_;
+      if (!count) return 0;
+      if constexpr (signature_traits<FunctionSignature>::ConstArguments)
+        if (!Awaited())
+          return DispatchBatch(count);
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        _Payload payload = Pop();
+        std::apply([this](auto&... args) { this->Invoke(args...); }, payload);
+      }
+      return count;
+    }
+
+    /*!
+     * \brief
+     *      Getter for the number of queued invokes
+     *
+     * \return
+     *      Returns the queue depth
+     */
+    [[nodiscard]] size_t QueueDepth() const
+    {
+      return size_;
+    }
+
+    /*!
+     * \brief
+     *      Getter for the number of invokes the ring buffer holds before growing
+     *
+     * \return
+     *      Returns the capacity of the ring buffer
+     */
+    [[nodiscard]] size_t QueueCapacity() const
+    {
+      return capacity_;
+    }
+
+    /*!
+     * \brief
+     *      Grows the ring buffer to hold at least 'count' invokes. Event::Reserve still makes
+     *      room for callbacks
+     *
+     * \param count
+     *      Number of invokes to make room for, rounded up to a power of two
+     */
+    void ReserveQueue(size_t count)
+    {
+      size_t capacity = capacity_ ? capacity_ : 1;
+      while (capacity < count) capacity *= 2;
+      if (capacity > capacity_) Grow(capacity);
+      batch_.reserve(count);
+    }
+
+    /*!
+     * \brief
+     *      Discards every queued invoke, keeping the ring buffer
+     */
+    void ClearQueue()
+    {
+      for (; size_; --size_, head_ = (head_ + 1) & (capacity_ - 1))
+        PayloadTraits::destroy(allocator_, buffer_ + head_);
+    }
+
+  private:
+    //! Allocator rebound to the queued arguments
+    using PayloadAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<_Payload>;
+    using PayloadTraits = std::allocator_traits<PayloadAllocator>; //!< Traits of the payload allocator
+
+    PayloadAllocator allocator_; //!< Allocator of the ring buffer
+    _Payload *buffer_ = nullptr; //!< Ring buffer of queued arguments
+    size_t capacity_ = 0;        //!< Size of the ring buffer, a power of two
+    size_t head_ = 0;            //!< Position of the oldest queued invoke
+    size_t size_ = 0;            //!< Number of queued invokes
+    std::vector<_Payload, PayloadAllocator> batch_; //!< Contiguous invokes of the last dispatch, kept for its capacity
+
+    /*!
+     * \brief
+     *      Checks if a coroutine waits on Next, which InvokeBatch does not resume
+     *
+     * \return
+     *      Returns true if a dispatch must invoke one queued invoke at a time
+     */
+    bool Awaited() const
+    {
+#ifdef EVENT_COROUTINES
+      return this->WaiterCount() != 0;
+#else
+      return false;
+#endif
+    }
+
+    /*!
+     * \brief
+     *      Moves the oldest queued invokes into a contiguous batch and invokes it
+     *
+     * \param count
+     *      Number of queued invokes to carry out
+     *
+     * \return
+     *      Returns 'count'
+     */
+    size_t DispatchBatch(size_t count)
+    {
+      // Taken out of the member so a dispatch from a callback fills a batch of its own
+      std::vector<_Payload, PayloadAllocator> batch(std::move(batch_));
+      batch.reserve(count);
+      for (size_t i = 0; i < count; ++i)
+        batch.push_back(Pop());
+      this->InvokeBatch(batch.data(), count);
+      batch.clear();
+      if (batch.capacity() > batch_.capacity()) batch_ = std::move(batch);
+      return count;
+    }
+
+    /*!
+     * \brief
+     *      Removes the oldest queued invoke
+     *
+     * \return
+     *      Returns the arguments of the oldest queued invoke
+     */
+    _Payload Pop()
+    {
+      _Payload &front = buffer_[head_];
+      _Payload payload(std::move(front));
+      PayloadTraits::destroy(allocator_, &front);
+      head_ = (head_ + 1) & (capacity_ - 1);
+      --size_;
+      return payload;
+    }
+
+    /*!
+     * \brief
+     *      Moves the queued invokes into a larger ring buffer
+     *
+     * \param capacity
+     *      Size of the new ring buffer, a power of two
+     */
+    void Grow(size_t capacity)
+    {
+      _Payload *buffer = PayloadTraits::allocate(allocator_, capacity);
+      for (size_t i = 0; i < size_; ++i)
+      {
+        _Payload &item = buffer_[(head_ + i) & (capacity_ - 1)];
+        PayloadTraits::construct(allocator_, buffer + i, std::move(item));
+        PayloadTraits::destroy(allocator_, &item);
+      }
+      if (buffer_) PayloadTraits::deallocate(allocator_, buffer_, capacity_);
+      buffer_ = buffer;
+      capacity_ = capacity;
+      head_ = 0;
+    }
+};
+
+/*!
+ * \brief
+ *      What AsyncEvent::Post does when the queue is full
+ */
+enum class EventOverflow
+{
+  Block,      //!< Wait for the owning thread to pump
+  DropNewest, //!< Discard the arguments being posted
+  DropOldest  //!< Discard the oldest queued arguments to make room
+};
+
+/*!
+ * \brief
+ *      Counters describing the queue of an AsyncEvent
+ */
+struct AsyncEventStats
+{
+  uint64_t posted = 0;    //!< Invokes queued by Post
+  uint64_t dropped = 0;   //!< Invokes discarded because the queue was full
+  uint64_t pumped = 0;    //!< Invokes carried out by Pump
+  uint64_t peakDepth = 0; //!< Largest queue depth seen by Post
+};
+
+/*!
+ * \brief
+ *      Event owned by one thread that any thread may post invokes to. Posted arguments go
+ *      through a bounded lock-free queue and the callbacks run on the owning thread when it
+ *      calls Pump
+ *      NOTE: Hooking, unhooking and invoking remain owning thread only
+ *
+ * \tparam FunctionSignature
+ *      Function signature of the callbacks to hold
+ *
+ * \tparam KeepOrder
+ *      Tells the system to invoke callbacks in the same order as they were hooked
+ *
+ * \tparam Allocator
+ *      Allocator for the call list
+ *
+ * \tparam Function
+ *      Type erased callable each callback is stored in
+ */
+template<typename FunctionSignature, bool KeepOrder = true, typename Allocator = std::allocator<Call<FunctionSignature>>,
+         typename Function = Delegate<FunctionSignature>>
+class AsyncEvent : public Event<FunctionSignature, KeepOrder, Allocator, Function>
+{
+  public:
+    using _Payload = typename signature_traits<FunctionSignature>::Payload; //!< Arguments stored per posted invoke
+
+    /*!
+     * \brief
+     *      Constructor
+     *
+     * \param capacity
+     *      Number of invokes the queue holds, rounded up to a power of two
+     *
+     * \param overflow
+     *      What Post does when the queue is full
+     */
+    explicit AsyncEvent(size_t capacity = 1024, EventOverflow overflow = EventOverflow::Block) : overflow_(overflow)
+    {
+      size_t size = 2;
+      while (size < capacity) size *= 2;
+      cells_.reset(new Cell[size]);
+      mask_ = size - 1;
+      for (size_t i = 0; i < size; ++i)
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    AsyncEvent(const AsyncEvent&) = delete;
+    AsyncEvent& operator=(const AsyncEvent&) = delete;
+
+    /*!
+     * \brief
+     *      Destructor, discards the queued invokes
+     *      NOTE: No thread may be posting
+     */
+    ~AsyncEvent()
+    {
+      while (Cell *cell = TryPop())
+        Release(cell);
+    }
+
+    /*!
+     * \brief
+     *      Queues an invoke from any thread, to be carried out by the owning thread's Pump
+     *
+     * \tparam Args
+     *      Types of the parameters passed in
+     *
+     * \param args
+     *      Parameters to pass to each of the callback functions
+     *      NOTE: Must be the same arguments as the FUNCTION_SIGNATURE
+     *
+     * \return
+     *      Returns false if the invoke was dropped because the queue was full
+     */
+    template<typename ...Args>
+    bool Post(Args&&... args)
+    {
+      static_assert(std::is_constructible_v<_Payload, Args&&...>, "Attempting to post event with differing arguments then the event function signature");
+
+      for (;;)
+      {
+        size_t position = tail_.load(std::memory_order_relaxed);
+        Cell *cell = nullptr;
+        while (!cell)
+        {
+          Cell &candidate = cells_[position & mask_];
+          intptr_t difference = intptr_t(candidate.sequence.load(std::memory_order_acquire)) - intptr_t(position);
+          if (difference == 0)
+          {
+            if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+              cell = &candidate;
+          }
+          else if (difference < 0)
+            break;
+          else
+            position = tail_.load(std::memory_order_relaxed);
+        }
+
+        if (cell)
+        {
+          ::new (static_cast<void*>(cell->storage)) _Payload(std::forward<Args>(args)...);
+          cell->sequence.store(position + 1, std::memory_order_release);
+          posted_.fetch_add(1, std::memory_order_relaxed);
+          UpdatePeak(position + 1);
+          return true;
+        }
+
+        switch (overflow_)
+        {
+          case EventOverflow::Block:
+            std::this_thread::yield();
+            break;
+          case EventOverflow::DropNewest:
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+          case EventOverflow::DropOldest:
+            if (Cell *oldest = TryPop())
+            {
+              Release(oldest);
+              dropped_.fetch_add(1, std::memory_order_relaxed);
+            }
+            break;
+        }
+      }
+    }
+
+    /*!
+     * \brief
+     *      Carries out posted invokes on the calling thread, which must own the event
+     *
+     * \param max
+     *      Maximum number of posted invokes to carry out
+     *
+     * \return
+     *      Returns the number of posted invokes carried out
+     */
+    size_t Pump(size_t max = std::numeric_limits<size_t>::max())
+    {
+      size_t count = 0;
+      for (Cell *cell; count < max && (cell = TryPop()) != nullptr; ++count)
+      {
+        _Payload arguments(std::move(cell->Payload()));
+        Release(cell);
+        std::apply([this](auto&... args) { this->Invoke(args...); }, arguments);
+      }
+      pumped_.fetch_add(count, std::memory_order_relaxed);
+      return count;
+    }
+
+    /*!
+     * \brief
+     *      Getter for the number of posted invokes waiting for Pump
+     *
+     * \return
+     *      Returns the queue depth, approximate while other threads post or pump
+     */
+    [[nodiscard]] size_t QueueDepth() const
+    {
+      // Loaded apart, the head may have passed the tail loaded or be far behind it
+      size_t head = head_.load(std::memory_order_relaxed);
+      size_t tail = tail_.load(std::memory_order_relaxed);
+      return tail > head ? std::min(tail - head, QueueCapacity()) : 0;
+    }
+
+    /*!
+     * \brief
+     *      Getter for the number of invokes the queue holds
+     *
+     * \return
+     *      Returns the capacity of the queue
+     */
+    [[nodiscard]] size_t QueueCapacity() const
+    {
+      return mask_ + 1;
+    }
+
+    /*!
+     * \brief
+     *      Getter for the counters of the queue
+     *
+     * \return
+     *      Returns a copy of the counters
+     */
+    [[nodiscard]] AsyncEventStats Stats() const
+    {
+      AsyncEventStats stats;
+      stats.posted = posted_.load(std::memory_order_relaxed);
+      stats.dropped = dropped_.load(std::memory_order_relaxed);
+      stats.pumped = pumped_.load(std::memory_order_relaxed);
+      stats.peakDepth = peakDepth_.load(std::memory_order_relaxed);
+      return stats;
+    }
+
+  private:
+    /*!
+     * \brief
+     *      Queue element, the sequence tells producers and consumers whose turn it is
+     */
+    struct Cell
+    {
+      std::atomic<size_t> sequence;                             //!< Position the cell is ready for
+      alignas(_Payload) unsigned char storage[sizeof(_Payload)]; //!< Posted arguments
+
+      /*!
+       * \brief
+       *      Gets the posted arguments
+       *
+       * \return
+       *      Returns the arguments constructed in the storage
+       */
+      _Payload& Payload()
+      {
+        return *std::launder(reinterpret_cast<_Payload*>(storage));
+      }
+    };
+
+    std::unique_ptr<Cell[]> cells_;                    //!< Ring of cells
+    size_t mask_ = 0;                                  //!< Capacity minus one
+    EventOverflow overflow_;                           //!< Policy when the queue is full
+    alignas(64) std::atomic<size_t> tail_{0};          //!< Next position to post to
+    alignas(64) std::atomic<size_t> head_{0};          //!< Next position to pump from
+    alignas(64) std::atomic<uint64_t> posted_{0};      //!< Invokes queued
+    std::atomic<uint64_t> dropped_{0};                 //!< Invokes discarded
+    std::atomic<uint64_t> pumped_{0};                  //!< Invokes carried out
+    std::atomic<uint64_t> peakDepth_{0};               //!< Largest queue depth seen
+
+    /*!
+     * \brief
+     *      Takes the oldest posted invoke out of the queue. Safe from any thread, posters
+     *      use it to drop the oldest invoke
+     *
+     * \return
+     *      Returns the cell, to be passed to Release, or nullptr if the queue is empty
+     */
+    Cell* TryPop()
+    {
+      size_t position = head_.load(std::memory_order_relaxed);
+      for (;;)
+      {
+        Cell &cell = cells_[position & mask_];
+        intptr_t difference = intptr_t(cell.sequence.load(std::memory_order_acquire)) - intptr_t(position + 1);
+        if (difference == 0)
+        {
+          if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            return &cell;
+        }
+        else if (difference < 0)
+          return nullptr;
+        else
+          position = head_.load(std::memory_order_relaxed);
+      }
+    }
+
+    /*!
+     * \brief
+     *      Destroys arguments taken by TryPop and hands their cell back to the posters
+     *
+     * \param cell
+     *      Cell returned by TryPop
+     */
+    void Release(Cell *cell)
+    {
+      size_t position = cell->sequence.load(std::memory_order_relaxed) - 1;
+      cell->Payload().~_Payload();
+      cell->sequence.store(position + mask_ + 1, std::memory_order_release);
+    }
+
+    /*!
+     * \brief
+     *      Records the queue depth after a post if it is the largest seen
+     *
+     * \param tail
+     *      Position after the posted invoke
+     */
+    void UpdatePeak(size_t tail)
+    {
+      size_t head = head_.load(std::memory_order_relaxed);
+      uint64_t depth = tail > head ? tail - head : 0;
+      uint64_t peak = peakDepth_.load(std::memory_order_relaxed);
+      while (depth > peak && !peakDepth_.compare_exchange_weak(peak, depth, std::memory_order_relaxed)) {}
+    }
+};
+
+/*!
+ * \brief
+ *      Counters describing the pending invokes of a CoalescedEvent
+ */
+struct CoalescedEventStats
+{
+  uint64_t posted = 0;      //!< Arguments handed to Post
+  uint64_t coalesced = 0;   //!< Posts merged into an invoke already pending, each one an invoke saved
+  uint64_t flushed = 0;     //!< Invokes carried out by Flush
+  uint64_t overflows = 0;   //!< Early flushes because every key was taken
+  uint64_t peakKeys = 0;    //!< Largest number of pending keys
+};
+
+/*!
+ * \brief
+ *      Event for high frequency producers whose callbacks only need the latest value. Posted
+ *      arguments replace, or are reduced into, the arguments pending for the same key and
+ *      the callbacks run once per pending key when Flush is called
+ *
+ * \tparam FunctionSignature
+ *      Function signature of the callbacks to hold
+ *
+ * \tparam Key
+ *      Type the posts are coalesced by, void keeps a single pending invoke for the event
+ *
+ * \tparam KeepOrder
+ *      Tells the system to invoke callbacks in the same order as they were hooked
+ *
+ * \tparam Allocator
+ *      Allocator for the call list and the pending invokes
+ *
+ * \tparam Function
+ *      Type erased callable each callback is stored in
+ */
+template<typename FunctionSignature, typename Key = void, bool KeepOrder = true,
+         typename Allocator = std::allocator<Call<FunctionSignature>>, typename Function = Delegate<FunctionSignature>>
+class CoalescedEvent : public Event<FunctionSignature, KeepOrder, Allocator, Function>
+{
+  public:
+    using _Payload = typename signature_traits<FunctionSignature>::Payload; //!< Arguments stored per pending invoke
+    using Reducer = Delegate<void(_Payload&, _Payload&)>; //!< Merges posted arguments into the pending ones
+
+    /*!
+     * \brief
+     *      Constructor
+     *
+     * \param capacity
+     *      Number of keys that may be pending at once, reaching it flushes early
+     */
+    explicit CoalescedEvent(size_t capacity = 1024)
+      : capacity_(std::is_void_v<Key> || capacity == 0 ? 1 : capacity), index_(MakeIndex(capacity_))
+    {
+      entries_.reserve(capacity_);
+      spare_.reserve(capacity_);
+    }
+
+    CoalescedEvent(const CoalescedEvent&) = delete;
+    CoalescedEvent& operator=(const CoalescedEvent&) = delete;
+
+    /*!
+     * \brief
+     *      Sets how posted arguments are merged into the arguments already pending for their key
+     *
+     * \param reducer
+     *      Called with the pending arguments and the posted ones, an empty reducer keeps the latest
+     */
+    void SetReducer(Reducer reducer)
+    {
+      reducer_ = std::move(reducer);
+    }
+
+    /*!
+     * \brief
+     *      Records an invoke to be carried out by Flush, coalesced with the one pending
+     *
+     * \tparam Args
+     *      Types of the parameters passed in
+     *
+     * \param args
+     *      Parameters to pass to each of the callback functions
+     *      NOTE: Must be the same arguments as the FUNCTION_SIGNATURE
+     *
+     * \return
+     *      Returns true if the arguments were coalesced with a pending invoke
+     */
+    template<typename ...Args, typename K = Key, typename = std::enable_if_t<std::is_void_v<K>>>
+    bool Post(Args&&... args)
+    {
+      static_assert(std::is_constructible_v<_Payload, Args&&...>, "Attempting to post event with differing arguments then the event function signature");
+      ++stats_.posted;
+      if (entries_.empty())
+      {
+        entries_.push_back(Entry{ NoKey{}, _Payload(std::forward<Args>(args)...) });
+        stats_.peakKeys = std::max<uint64_t>(stats_.peakKeys, 1);
+        return false;
+      }
+      Merge(entries_.front().payload, std::forward<Args>(args)...);
+      return true;
+    }
+
+    /*!
+     * \brief
+     *      Records an invoke to be carried out by Flush, coalesced with the one pending for 'key'
+     *
+     * \tparam Args
+     *      Types of the parameters passed in
+     *
+     * \param key
+     *      Key the invoke is coalesced by
+     *
+     * \param args
+     *      Parameters to pass to each of the callback functions
+     *      NOTE: Must be the same arguments as the FUNCTION_SIGNATURE
+     *
+     * \return
+     *      Returns true if the arguments were coalesced with a pending invoke
+     */
+    template<typename K = Key, typename ...Args, typename = std::enable_if_t<!std::is_void_v<K>>>
+    bool Post(const K &key, Args&&... args)
+    {
+      static_assert(std::is_constructible_v<_Payload, Args&&...>, "Attempting to post event with differing arguments then the event function signature");
+      ++stats_.posted;
+      uint32_t *position = index_.Find(key, entries_);
+      if (position)
+      {
+        Merge(entries_[*position].payload, std::forward<Args>(args)...);
+        return true;
+      }
+
+      if (entries_.size() == capacity_)
+      {
+        ++stats_.overflows;
+        Flush();
+      }
+      index_.Insert(key, entries_);
+      entries_.push_back(Entry{ key, _Payload(std::forward<Args>(args)...) });
+      stats_.peakKeys = std::max<uint64_t>(stats_.peakKeys, entries_.size());
+      return false;
+    }
+
+    /*!
+     * \brief
+     *      Invokes every callback once for each key pending before the call, in the order the
+     *      keys were first posted. Posts made by the callbacks are left for the next flush
+     *      NOTE: If a callback throws, the rest of the flushed invokes are discarded
+     *
+     * \return
+     *      Returns the number of invokes carried out
+     */
+    size_t Flush()
+    {
+      Entries flushing;
+      flushing.swap(entries_);
+      entries_.swap(spare_);
+      if constexpr (!std::is_void_v<Key>)
+        index_.Clear();
+
+      size_t count = flushing.size();
+      stats_.flushed += count;
+      for (Entry &entry : flushing)
+        std::apply([this](auto&... args) { this->Invoke(args...); }, entry.payload);
+
+      flushing.clear();
+      if (flushing.capacity() > spare_.capacity()) spare_.swap(flushing);
+      return count;
+    }
+
+    /*!
+     * \brief
+     *      Getter for the number of keys waiting for Flush
+     *
+     * \return
+     *      Returns the number of pending invokes
+     */
+    [[nodiscard]] size_t PendingCount() const
+    {
+      return entries_.size();
+    }
+
+    /*!
+     * \brief
+     *      Getter for the number of keys that may be pending at once
+     *
+     * \return
+     *      Returns the capacity given at construction
+     */
+    [[nodiscard]] size_t PendingCapacity() const
+    {
+      return capacity_;
+    }
+
+    /*!
+     * \brief
+     *      Getter for the counters of the pending invokes
+     *
+     * \return
+     *      Returns a copy of the counters
+     */
+    [[nodiscard]] CoalescedEventStats Stats() const
+    {
+      return stats_;
+    }
+
+    /*!
+     * \brief
+     *      Discards every pending invoke, keeping the storage
+     */
+    void ClearPending()
+    {
+      entries_.clear();
+      if constexpr (!std::is_void_v<Key>)
+        index_.Clear();
+    }
+
+  private:
+    struct NoKey {}; //!< Key of the single pending invoke of an unkeyed event
+    using KeyType = std::conditional_t<std::is_void_v<Key>, NoKey, Key>; //!< Key stored with each pending invoke
+
+    /*!
+     * \brief
+     *      Pending invoke and the key it is coalesced by
+     */
+    struct Entry
+    {
+      KeyType key;      //!< Key the invoke is coalesced by
+      _Payload payload; //!< Arguments to invoke with
+    };
+
+    //! Pending invokes in the order their key was first posted
+    using Entries = std::vector<Entry, typename std::allocator_traits<Allocator>::template rebind_alloc<Entry>>;
+
+    /*!
+     * \brief
+     *      Open addressing table from a key to the position of its pending invoke, which
+     *      holds the key. Sized once for the capacity, so posting never allocates, and
+     *      cleared by moving to a new stamp, so a flush touches none of its buckets
+     */
+    class Index
+    {
+        //! Bucket of the table
+        struct Bucket
+        {
+          uint32_t stamp;    //!< Stamp the bucket was filled under, empty if not the current one
+          uint32_t position; //!< Position of the pending invoke
+        };
+
+        //! Allocator rebound to the table
+        using BucketAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Bucket>;
+
+      public:
+        /*!
+         * \brief
+         *      Constructor
+         *
+         * \param capacity
+         *      Number of keys that may be indexed at once
+         */
+        explicit Index(size_t capacity)
+        {
+          size_t size = 16;
+          while (capacity * 4 > size * 3) size *= 2;
+          buckets_.assign(size, Bucket{ 0, 0 });
+        }
+
+        /*!
+         * \brief
+         *      Finds the pending invoke of a key
+         *
+         * \param key
+         *      Key to look up
+         *
+         * \param entries
+         *      Pending invokes the positions refer to
+         *
+         * \return
+         *      Returns a pointer to the position of the invoke, or nullptr if the key is not pending
+         */
+        uint32_t* Find(const KeyType &key, const Entries &entries)
+        {
+          Bucket &bucket = Probe(key, entries);
+          return bucket.stamp == stamp_ ? &bucket.position : nullptr;
+        }
+
+        /*!
+         * \brief
+         *      Indexes a key that is not pending, at the position past the pending invokes
+         *
+         * \param key
+         *      Key to index
+         *
+         * \param entries
+         *      Pending invokes, the key's invoke is appended next
+         */
+        void Insert(const KeyType &key, const Entries &entries)
+        {
+          Probe(key, entries) = Bucket{ stamp_, uint32_t(entries.size()) };
+        }
+
+        /*!
+         * \brief
+         *      Removes every key, keeping the table
+         */
+        void Clear()
+        {
+          if (++stamp_ != 0) return;
+          std::fill(buckets_.begin(), buckets_.end(), Bucket{ 0, 0 });
+          stamp_ = 1;
+        }
+
+      private:
+        std::vector<Bucket, BucketAllocator> buckets_; //!< Power of two sized table, at most three quarters full
+        uint32_t stamp_ = 1;                           //!< Stamp of the filled buckets
+
+        /*!
+         * \brief
+         *      Finds the bucket holding a key, or the empty one it would be added to
+         */
+        Bucket& Probe(const KeyType &key, const Entries &entries)
+        {
+          size_t mask = buckets_.size() - 1;
+          uint64_t x = std::hash<KeyType>()(key);
+          x ^= x >> 33;
+          x *= 0xff51afd7ed558ccdull;
+          x ^= x >> 33;
+          for (size_t i = size_t(x) & mask;; i = (i + 1) & mask)
+          {
+            Bucket &bucket = buckets_[i];
+            if (bucket.stamp != stamp_ || entries[bucket.position].key == key)
+              return bucket;
+          }
+        }
+    };
+
+    size_t capacity_;            //!< Number of keys that may be pending at once
+    Entries entries_;            //!< Pending invokes
+    Entries spare_;              //!< Storage handed to entries_ by the next flush
+    std::conditional_t<std::is_void_v<Key>, NoKey, Index> index_; //!< Position of each pending key
+    Reducer reducer_;            //!< Merges posted arguments, empty keeps the latest
+    CoalescedEventStats stats_;  //!< Counters
+
+    /*!
+     * \brief
+     *      Makes the index of the pending keys, none for an unkeyed event
      *
-     * \param func_ptr
-     *      Pointer to non-static member function to unhook
+     * \param capacity
+     *      Number of keys that may be pending at once
      */
-    template<typename C, typename Fn>
-    void Unhook(C &class_ref, Fn func_ptr)
-    VERIFY_TYPE(class_member_inclusion<C, Fn>())
+    static auto MakeIndex([[maybe_unused]] size_t capacity)
     {
-      RemoveCall(GET_HANDLE(POINTER_INT_CAST(&class_ref), POINTER_INT_CAST(func_ptr)));
+      if constexpr (std::is_void_v<Key>)
+        return NoKey{};
+      else
+        return Index(capacity);
     }
 
     /*!
      * \brief
-     *      Unhooks a function that a handle corresponds to
-     *      NOTE: Attempting to use a handle given for a cluster
-     *            will not remove anything
+     *      Coalesces posted arguments with the ones pending
      *
-     * \param handle
-     *      Handle corresponding to the function to unhook
+     * \param pending
+     *      Arguments of the pending invoke
+     *
+     * \param args
+     *      Posted arguments
      */
-    void Unhook(EVENT_HANDLE handle)
+    template<typename ...Args>
+    void Merge(_Payload &pending, Args&&... args)
     {
-      RemoveCall(handle);
+      ++stats_.coalesced;
+      _Payload posted(std::forward<Args>(args)...);
+      if (reducer_)
+        reducer_(pending, posted);
+      else
+        pending = std::move(posted);
     }
+};
+
+/*!
+ * \brief
+ *      Counters describing an EventBus
+ */
+struct EventBusStats
+{
+  size_t events = 0;    //!< Message types with an event on the bus
+  size_t callbacks = 0; //!< Callbacks hooked across every event
+  size_t bytes = 0;     //!< Bytes held by the bus and its events, see Event::MemoryUsage
+};
+
+/*!
+ * \brief
+ *      Owns one Event per message type, in place of a function-local static per event.
+ *      Every message type gets a dense index the first time any bus uses it, so Get and
+ *      Publish are an array access with no hashing and no static initialization guard.
+ *      Callbacks take the message by const reference
+ *      NOTE: Like Event, a bus is not thread safe
+ */
+class EventBus
+{
+  public:
+    //! Type of the event of a message type
+    template<typename Msg>
+    using EventType = Event<void(const Msg&)>;
 
     /*!
      * \brief
-     *      Unhooks the cluster of functions corresponding to the handle
+     *      Default Constructor, events are added as their message types are first used
+     */
+    EventBus() = default;
+
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    /*!
+     * \brief
+     *      Gets the event of a message type, adding it on first use
      *
-     * \param handle
-     *      Handle corresponding to the cluster of cuntions hooked by Hook##Cluster functions
+     * \tparam Msg
+     *      Message type
+     *
+     * \return
+     *      Returns the event, valid as long as the bus
      */
-    void UnhookCluster(EVENT_HANDLE handle)
+    template<typename Msg>
+    EventType<Msg>& Get()
     {
-      RemoveCluster(GET_CLUSTER(handle));
+      if (EventType<Msg> *event = Find<Msg>()) return *event;
+      return Add<Msg>();
     }
 
     /*!
      * \brief
-     *      Unhooks all non-static member functions hooked with the
-     *      user defined type
+     *      Gets the event of a message type if it was added
      *
-     * \tparam C
-     *      Type of user defined type
+     * \tparam Msg
+     *      Message type
      *
-     * \param class_ref
-     *      Reference to class has non-static member functions hooked to event
+     * \return
+     *      Returns the event, or nullptr if no one has used it on this bus
      */
-    template<typename C>
-    void UnhookClass(C &class_ref)
+    template<typename Msg>
+    [[nodiscard]] EventType<Msg>* Find()
     {
-      static_assert(std::is_class_v<C>, "Class pointer provided not a pointer to a class");
-      RemoveCluster(GET_HANDLE(POINTER_INT_CAST(&class_ref), POINTER_INT_CAST(nullptr)));
+      static_assert(std::is_same_v<Msg, std::decay_t<Msg>>, "Message types must not be const, volatile or references");
+      size_t index = TypeIndex<Msg>();
+      if (index >= events_.size() || !events_[index]) return nullptr;
+      return &static_cast<TypedEntry<Msg>&>(*events_[index]).event;
     }
 
     /*!
      * \brief
-     *      Unhooks a list of non-member functions hooked to the event
+     *      Invokes the event of a message type with a message. Does nothing, and adds no
+     *      event, if no one has used the message type on this bus
      *
-     * \tparam Fs
-     *      List of non-member function types
+     * \tparam Msg
+     *      Message type
      *
-     * \param func_ptrs
-     *      List of non-member functions to unhook from event
+     * \param msg
+     *      Message to pass to each callback
      */
-    template<typename ...Fns>
-    void UnhookFunctions(Fns ...func_ptrs)
-    VERIFY_TYPE(class_member_exclusion<Fns...>() && type_exclusion<EVENT_HANDLE, Fns...>())
+    template<typename Msg>
+    void Publish(const Msg &msg)
     {
-      PACK_EXPAND(Unhook, func_ptrs)
+      if (EventType<Msg> *event = Find<Msg>()) event->Invoke(msg);
     }
 
     /*!
      * \brief
-     *      Unhooks a list of non-static member functions both hooked to event
-     *      and contained within the class of type C
-     *
-     * \tparam C
-     *      Type of user defined type
-     *
-     * \tparam Fs
-     *      List of non-static member function types
-     *
-     * \param class_ref
-     *      Reference to class that contains the non-static member functions
-     *      to unhook
+     *      Constructs a message from arguments and invokes the event of its type. The message
+     *      is only constructed if the event was added
      *
-     * \param func_ptrs
-     *      List of non-static member functions contained in class C to unhook from event
+     * \tparam Msg
+     *      Message type
      *
+     * \param args
+     *      Arguments to construct the message from
      */
-    template<typename C, typename ...Fns>
-    void UnhookMethods(C &class_ref, Fns ...func_ptrs)
-    VERIFY_TYPE(class_member_inclusion<C, Fns...>() && type_exclusion<EVENT_HANDLE, Fns...>())
+    template<typename Msg, typename ...Args>
+    void Publish(Args&&... args)
     {
-      PACK_EXPAND(Unhook, class_ref, func_ptrs)
+      EventType<Msg> *event = Find<Msg>();
+      if (!event) return;
+      if constexpr (sizeof...(Args) == 1 && (std::is_same_v<std::decay_t<Args>, Msg> && ...))
+        event->Invoke(args...);
+      else
+        event->Invoke(Msg{ std::forward<Args>(args)... });
     }
 
     /*!
      * \brief
-     *      Getter for how many callbacks are stored within this event
-     *
-     * \return
-     *      Returns number of callbacks hooked to this event
+     *      Clears the call list of every event on the bus, keeping the events
      */
-    [[nodiscard]] size_t CallListSize() const
+    void Clear()
     {
-        return callList_.size();
+      for (auto &entry : events_)
+        if (entry) entry->Clear();
     }
 
     /*!
      * \brief
-     *      Clears the call list
+     *      Getter for the events, callbacks and bytes of the bus
+     *
+     * \return
+     *      Returns the counters
      */
-    void Clear()
+    [[nodiscard]] EventBusStats Stats() const
     {
-        callList_.clear();
-        clusterHandle_ = 0;
+      EventBusStats stats;
+      stats.bytes = sizeof(*this) + events_.capacity() * sizeof(std::unique_ptr<Entry>);
+      for (const auto &entry : events_)
+      {
+        if (!entry) continue;
+        ++stats.events;
+        stats.callbacks += entry->CallListSize();
+        stats.bytes += entry->MemoryUsage();
+      }
+      return stats;
     }
+
   private:
-    struct USet; struct CallHash; // forward declare
+    //! Event of a message type, erased so the bus can hold every type together
+    struct Entry
+    {
+      virtual ~Entry() = default;
+      virtual void Clear() = 0;
+      virtual size_t CallListSize() const = 0;
+      virtual size_t MemoryUsage() const = 0;
+    };
+
+    //! Event of the message type Msg
+    template<typename Msg>
+    struct TypedEntry final : Entry
+    {
+      EventType<Msg> event;
+
+      void Clear() override { event.Clear(); }
+      size_t CallListSize() const override { return event.CallListSize(); }
+      size_t MemoryUsage() const override { return sizeof(*this) - sizeof(event) + event.MemoryUsage(); }
+    };
 
-    //! Type of callback list
-    using CallListType = std::conditional_t<Ordered, std::vector<Call<_Signature>, _Allocator>, USet>;
+    std::vector<std::unique_ptr<Entry>> events_; //!< Event of each message type, by type index
 
-    CallListType callList_;          //!< List of callbacks
-    EVENT_HANDLE clusterHandle_ = 0; //!< Cluster handle to differ from class address
+    template<typename Msg>
+    inline static std::atomic<size_t> typeIndex_{0}; //!< Index of each message type plus one, 0 until first used
+    inline static std::mutex typeMutex_;             //!< Serializes handing out type indices
+    inline static size_t typeCount_ = 0;             //!< Type indices handed out, guarded by typeMutex_
 
     /*!
      * \brief
-     *      Unhooks a cluster handle from the call list
+     *      Gets the index of a message type, shared by every bus
+     *
+     * \tparam Msg
+     *      Message type
      *
-     * \param cluster
-     *      Handle to cluster of events to unhook
+     * \return
+     *      Returns the index
      */
-    void RemoveCluster(EVENT_HANDLE cluster)
+    template<typename Msg>
+    static size_t TypeIndex()
     {
-      for (auto it = callList_.begin(); it != callList_.end();)
-        if (cluster == GET_CLUSTER(it->handle))
-          it = callList_.erase(it);
-        else
-          ++it;
+      size_t index = typeIndex_<Msg>.load(std::memory_order_acquire);
+      return index ? index - 1 : AssignTypeIndex(typeIndex_<Msg>);
     }
 
     /*!
      * \brief
-     *      Unhooks a handle from the call list
+     *      Hands out the next type index on the first use of a message type
      *
-     * \param handle
-     *      Handle to the function to unhook
+     * \param index
+     *      Index of the message type plus one, set if still 0
+     *
+     * \return
+     *      Returns the index
      */
-    void RemoveCall(EVENT_HANDLE handle)
+    static size_t AssignTypeIndex(std::atomic<size_t> &index)
     {
-      auto call = std::find(callList_.begin(), callList_.end(), handle);
-      if (call != callList_.end()) callList_.erase(call);
+      std::lock_guard<std::mutex> lock(typeMutex_);
+      if (size_t assigned = index.load(std::memory_order_relaxed)) return assigned - 1;
+      index.store(++typeCount_, std::memory_order_release);
+      return typeCount_ - 1;
     }
 
     /*!
      * \brief
-     *      Converts a pointer into an std::uintptr_t for the EVENT_HANDLE
-     *
-     * \tparam T
-     *      Type of pointer
+     *      Adds the event of a message type
      *
-     * \param t
-     *      Pointer to hash
+     * \tparam Msg
+     *      Message type
      *
      * \return
-     *      Returns the address of the pointer as an int
+     *      Returns the event
      */
-    template<typename T>
-    static constexpr std::uintptr_t POINTER_INT_CAST(T t)
+    template<typename Msg>
+    EventType<Msg>& Add()
     {
-        return reinterpret_cast<std::uintptr_t>(*reinterpret_cast<void**>(&t));
+      size_t index = TypeIndex<Msg>();
+      if (index >= events_.size()) events_.resize(index + 1);
+      auto entry = std::make_unique<TypedEntry<Msg>>();
+      EventType<Msg> &event = entry->event;
+      events_[index] = std::move(entry);
+      return event;
     }
+};
 
+/*!
+ * \brief
+ *      Work stealing thread pool used as the executor of Event::InvokeParallel.
+ *      Each worker owns a queue of chunks, takes work from its own end and steals
+ *      from the other end of the others. The calling thread works until its job is done
+ */
+class EventThreadPool
+{
+  public:
     /*!
      * \brief
-     *      Hash functor used in unordered_set
+     *      Constructor, starts the workers
+     *
+     * \param threads
+     *      Total threads working on a job, the calling thread included
      */
-    struct CallHash
+    explicit EventThreadPool(size_t threads = std::thread::hardware_concurrency())
     {
-      /*!
-       * \brief
-       *      Function call operator
-       *
-       * \param call
-       *      Call to hash
-       *
-       * \return
-       *      Returns the handle of the call
-       */
-      EVENT_HANDLE operator()(const Call<_Signature>& call) const
-      {
-        return call.handle;
-      }
-    };
+      size_t workers = threads > 1 ? threads - 1 : 0;
+      for (size_t i = 0; i < workers; ++i)
+        queues_.emplace_back(new Queue);
+      for (size_t i = 0; i < workers; ++i)
+        workers_.emplace_back([this, i]() { Work(i); });
+    }
+
+    EventThreadPool(const EventThreadPool&) = delete;
+    EventThreadPool& operator=(const EventThreadPool&) = delete;
 
     /*!
      * \brief
-     *      Wrapper around an unordered_set to standard the emplace_back function
+     *      Destructor, stops and joins the workers. A worker only stops once it finds no chunk
+     *      queued, so none is left unrun
+     *      NOTE: No ParallelFor may be running on the pool
      */
-    struct USet : public std::unordered_set<Call<_Signature>, CallHash, std::equal_to<Call<_Signature>>, _Allocator>
+    ~EventThreadPool()
     {
-      /*!
-       * \brief
-       *      Wrapper around emplace to work with std::vector
-       *
-       * \tparam Args
-       *      Argument types to the constructor of Call
-       *
-       * \param args
-       *      Arguments to the constructor of Call data type
-       */
-      template<typename ...Args>
-      void emplace_back(Args... args)
       {
-        bool added = this->emplace(args...).second;
-        assert(added && "ERROR : Duplicate function hooked to event");
+        std::lock_guard<std::mutex> lock(sleep_);
+        stop_ = true;
       }
-    };
+      wake_.notify_all();
+      for (auto &worker : workers_)
+        worker.join();
+    }
 
     /*!
      * \brief
-     *      Base case, not a member function of a class
+     *      Getter for the threads working on a job
+     *
+     * \return
+     *      Returns the number of workers plus the calling thread
      */
-    template<typename, typename>
-    struct is_member_function_of
+    [[nodiscard]] size_t ThreadCount() const
     {
-      static constexpr bool value = false;
-    };
+      return workers_.size() + 1;
+    }
 
     /*!
      * \brief
-     *      Overload for non-static non-ellipsis member functions
+     *      Runs 'body' over [0, count) in chunks of 'grain', returning once every chunk ran
+     *      NOTE: 'body' must not throw
+     *
+     * \tparam Body
+     *      Callable taking the begin and end of a chunk
+     *
+     * \param count
+     *      Size of the range
+     *
+     * \param grain
+     *      Size of a chunk
+     *
+     * \param body
+     *      Callable run for each chunk
      */
-    #define DEF_IS_MEMBER_FUNCTION_OF(CV_REF_NOEXCEPT_OPT) \
-      template<typename C, typename R, typename... Args> \
-      struct is_member_function_of<C, R(C::*)(Args...) CV_REF_NOEXCEPT_OPT> \
-      { \
-          static constexpr bool value = true; \
+    template<typename Body>
+    void ParallelFor(size_t count, size_t grain, Body &&body)
+    {
+      grain = grain ? grain : 1;
+      size_t chunks = (count + grain - 1) / grain;
+      if (chunks <= 1 || queues_.empty())
+      {
+        if (count) body(size_t(0), count);
+        return;
       }
 
+      Job job;
+      job.run = [](const void *context, size_t begin, size_t end)
+      { (*static_cast<std::remove_reference_t<Body>*>(const_cast<void*>(context)))(begin, end); };
+      job.body = &body;
+      job.remaining.store(chunks, std::memory_order_relaxed);
+
+      for (size_t chunk = 0; chunk < chunks; ++chunk)
+      {
+        Queue &queue = *queues_[chunk % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.lock);
+        queue.chunks.push_back({&job, chunk * grain, std::min(count, (chunk + 1) * grain)});
+      }
+      {
+        std::lock_guard<std::mutex> lock(sleep_);
+        queued_ += chunks;
+      }
+      wake_.notify_all();
+
+      while (job.remaining.load(std::memory_order_acquire))
+      {
+        Chunk chunk;
+        if (Steal(queues_.size(), chunk))
+          Run(chunk);
+        else
+          std::this_thread::yield();
+      }
+    }
+
+  private:
     /*!
      * \brief
-     *     Overload for non-static ellipsis member functions
+     *      Range of work shared by every chunk of a ParallelFor
      */
-    #define DEF_IS_MEMBER_FUNCTION_OF_ELLIPSIS(CV_REF_NOEXCEPT_OPT) \
-      template<typename C, typename R, typename... Args> \
-      struct is_member_function_of<C, R(C::*)(Args..., ...) CV_REF_NOEXCEPT_OPT> \
-      { \
-          static constexpr bool value = true; \
-      }
+    struct Job
+    {
+      void (*run)(const void*, size_t, size_t); //!< Calls the body with a chunk
+      const void *body;                          //!< Body of the ParallelFor
+      std::atomic<size_t> remaining;             //!< Chunks not yet finished
+    };
 
     /*!
      * \brief
-     *      Generates all overloads for member functions and their decorators
-     *
-     * \tparam C
-     *      Class type
-     *
-     * \tparam R
-     *      Return type
-     *
-     * \tparam Args
-     *      Argument type list
+     *      Part of a job's range
      */
-    PERMUTE_PMF(DEF_IS_MEMBER_FUNCTION_OF);
+    struct Chunk
+    {
+      Job *job;     //!< Job the chunk belongs to
+      size_t begin; //!< First index of the chunk
+      size_t end;   //!< One past the last index of the chunk
+    };
 
     /*!
      * \brief
-     *      Base case, is a lambda, check if it can be constructed as an std::function
+     *      Queue of chunks owned by a worker
      */
-    template<typename COMP, typename Fn>
-    struct parameter_equivalents
-    { static constexpr bool value = std::is_constructible_v<std::function<_Signature>, Fn>; };
+    struct alignas(64) Queue
+    {
+      std::mutex lock;          //!< Guards the chunks
+      std::deque<Chunk> chunks; //!< Chunks waiting to run
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_; //!< One queue per worker
+    std::vector<std::thread> workers_;           //!< Worker threads
+    std::mutex sleep_;                           //!< Guards queued_ and stop_ for sleeping workers
+    std::condition_variable wake_;               //!< Wakes sleeping workers
+    size_t queued_ = 0;                          //!< Chunks queued but not yet taken
+    bool stop_ = false;                          //!< Tells the workers to exit
 
     /*!
      * \brief
-     *     Non-member function overload to see if COMP can be invoked with arguments Args
+     *      Takes a chunk from the back of the worker's own queue, else steals one
+     *      from the front of another queue
      *
-     * \tparam COMP
-     *     Function type to be invoked
+     * \param self
+     *      Index of the worker's queue, or the number of queues for the calling thread
      *
-     * \tparam R
-     *     Return type of non-member function
+     * \param chunk
+     *      Receives the chunk taken
      *
-     * \tparam Args
-     *     Argument list of non-member function
+     * \return
+     *      Returns true if a chunk was taken
      */
-    template<typename COMP, typename R, typename ...Args>
-    struct parameter_equivalents<COMP, R(*)(Args...)>
-    { static constexpr bool value = std::is_invocable_v<COMP, Args...>; };
+    bool Steal(size_t self, Chunk &chunk)
+    {
+      for (size_t i = 0; i < queues_.size(); ++i)
+      {
+        size_t victim = (self + i) % queues_.size();
+        Queue &queue = *queues_[victim];
+        std::lock_guard<std::mutex> lock(queue.lock);
+        if (queue.chunks.empty()) continue;
 
-    /*!
-     * \brief
-     *      Overload for non-static non-ellipsis member function
-     */
-    #define DEF_PARAMETER_EQUIVALENTS(CV_REF_NOEXCEPT_OPT) \
-    template<typename COMP, typename C, typename R, typename ...Args> \
-    struct parameter_equivalents<COMP, R(C::*)(Args...) CV_REF_NOEXCEPT_OPT> \
-    { static constexpr bool value = std::is_invocable_v<COMP, Args...>; };
+        if (victim == self)
+        {
+          chunk = queue.chunks.back();
+          queue.chunks.pop_back();
+        }
+        else
+        {
+          chunk = queue.chunks.front();
+          queue.chunks.pop_front();
+        }
+
+        std::lock_guard<std::mutex> sleep(sleep_);
+        --queued_;
+        return true;
+      }
+      return false;
+    }
 
     /*!
      * \brief
-     *      Overload for non-static ellipsis member function
+     *      Runs a chunk and marks it finished
+     *
+     * \param chunk
+     *      Chunk to run
      */
-    #define DEF_PARAMETER_EQUIVALENTS_ELLIPSIS(CV_REF_NOEXCEPT_OPT) \
-    template<typename COMP, typename C, typename R, typename ...Args> \
-    struct parameter_equivalents<COMP, R(C::*)(Args..., ...) CV_REF_NOEXCEPT_OPT> \
-    { static constexpr bool value = std::is_invocable_v<COMP, Args...>; };
+    static void Run(const Chunk &chunk)
+    {
+      chunk.job->run(chunk.job->body, chunk.begin, chunk.end);
+      chunk.job->remaining.fetch_sub(1, std::memory_order_acq_rel);
+    }
 
     /*!
      * \brief
-     *      Generates all overloads to check if COMP can be invoked with
-     *      the arguments of Args
-     *
-     * \tparam COMP
-     *      Function signature to be invoked with arguments Args
-     *
-     * \tparam C
-     *      Type of class
+     *      Worker loop, runs chunks until the pool stops
      *
-     * \tparam R
-     *      Return type
-     *
-     * \tparam Args
-     *      List of argument types
+     * \param self
+     *      Index of the worker's queue
      */
-    PERMUTE_PMF(DEF_PARAMETER_EQUIVALENTS);
+    void Work(size_t self)
+    {
+      for (;;)
+      {
+        Chunk chunk;
+        if (Steal(self, chunk))
+        {
+          Run(chunk);
+          continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_);
+        wake_.wait(lock, [this]() { return stop_ || queued_; });
+        if (stop_) return;
+      }
+    }
 };
 
 #endif
@@ -0,0 +1,48 @@
+/*!
+ * \file AbstractArgument.cpp
+ * \brief
+ *      Events taking abstract classes by reference, whose arguments cannot be stored by value,
+ *      compile and invoke when Next is never awaited. Built as C++20 so the coroutine support
+ *      in Invoke is compiled too.
+ */
+#include "Events.hpp"
+#include "Test.hpp"
+
+namespace
+{
+  struct Shape
+  {
+    virtual ~Shape() = default;
+    [[nodiscard]] virtual int Sides() const = 0;
+  };
+
+  struct Square : Shape
+  {
+    [[nodiscard]] int Sides() const override { return 4; }
+  };
+
+  void AbstractReference()
+  {
+    Event<void(const Shape&)> drawn;
+    int sides = 0;
+    drawn.Hook([&sides](const Shape &shape) { sides += shape.Sides(); });
+    drawn.Invoke(Square());
+
+    Square square;
+    const Shape &shape = square;
+    drawn.Invoke(shape);
+    CHECK(sides == 8);
+
+    Event<int(Shape&)> counted;
+    counted.Hook([](Shape &s) { return s.Sides(); });
+    CollectSum<int> sum;
+    counted.InvokeCollect(sum, square);
+    CHECK(sum.value == 4);
+  }
+}
+
+int main()
+{
+  AbstractReference();
+  return test::Result();
+}
@@ -0,0 +1,174 @@
+/*!
+ * \file AsyncEvent.cpp
+ * \brief
+ *      AsyncEvent delivers every invoke posted from any number of threads exactly once, in post
+ *      order per thread, on the thread that pumps, and applies its overflow policy and
+ *      counters once the queue is full.
+ */
+#include "Events.hpp"
+#include "Test.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  constexpr int Producers = 4;        //!< Threads posting at once
+  constexpr int PerProducer = 20000;  //!< Invokes posted by each thread
+
+  void ManyProducersOnePumper()
+  {
+    AsyncEvent<void(int, int)> event(256);
+    std::vector<int> received(Producers * PerProducer, 0);
+    std::vector<int> last(Producers, -1);
+    bool ordered = true;
+    std::thread::id pumper = std::this_thread::get_id();
+    bool onPumper = true;
+    event.Hook([&](int producer, int value)
+    {
+      ++received[producer * PerProducer + value];
+      ordered = ordered && value > last[producer];
+      last[producer] = value;
+      onPumper = onPumper && std::this_thread::get_id() == pumper;
+    });
+
+    std::atomic<bool> done{false};
+    bool depthInRange = true;
+    std::thread observer([&]()
+    {
+      while (!done.load())
+        depthInRange = depthInRange && event.QueueDepth() <= event.QueueCapacity();
+    });
+
+    std::vector<std::thread> threads;
+    for (int producer = 0; producer < Producers; ++producer)
+      threads.emplace_back([&event, producer]()
+      {
+        for (int value = 0; value < PerProducer; ++value)
+          event.Post(producer, value);
+      });
+
+    size_t pumped = 0;
+    while (pumped < size_t(Producers * PerProducer))
+      pumped += event.Pump();
+    for (std::thread &thread : threads)
+      thread.join();
+    done = true;
+    observer.join();
+
+    bool exactlyOnce = true;
+    for (int count : received)
+      exactlyOnce = exactlyOnce && count == 1;
+    CHECK(exactlyOnce);
+    CHECK(ordered);
+    CHECK(onPumper);
+    CHECK(depthInRange);
+    CHECK(event.QueueDepth() == 0);
+
+    AsyncEventStats stats = event.Stats();
+    CHECK(stats.posted == uint64_t(Producers * PerProducer));
+    CHECK(stats.pumped == stats.posted);
+    CHECK(stats.dropped == 0);
+    CHECK(stats.peakDepth >= 1 && stats.peakDepth <= event.QueueCapacity());
+  }
+
+  void Block()
+  {
+    AsyncEvent<void(int)> event(4, EventOverflow::Block);
+    std::vector<int> seen;
+    event.Hook([&seen](int value) { seen.push_back(value); });
+    CHECK(event.QueueCapacity() == 4);
+    for (int i = 0; i < 4; ++i)
+      CHECK(event.Post(i));
+
+    // The fifth post waits for room
+    std::atomic<bool> posted{false};
+    std::thread producer([&]() { posted = event.Post(4); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CHECK(!posted.load());
+    CHECK(event.QueueDepth() == 4);
+
+    CHECK(event.Pump(1) == 1);
+    producer.join();
+    CHECK(posted.load());
+    CHECK(event.Pump() == 4);
+    CHECK((seen == std::vector<int>{ 0, 1, 2, 3, 4 }));
+
+    AsyncEventStats stats = event.Stats();
+    CHECK(stats.posted == 5 && stats.pumped == 5 && stats.dropped == 0);
+    CHECK(stats.peakDepth == 4);
+  }
+
+  void DropNewest()
+  {
+    AsyncEvent<void(int)> event(4, EventOverflow::DropNewest);
+    std::vector<int> seen;
+    event.Hook([&seen](int value) { seen.push_back(value); });
+    for (int i = 0; i < 4; ++i)
+      CHECK(event.Post(i));
+    CHECK(!event.Post(4));
+    CHECK(!event.Post(5));
+    CHECK(event.QueueDepth() == 4);
+
+    CHECK(event.Pump() == 4);
+    CHECK((seen == std::vector<int>{ 0, 1, 2, 3 }));
+
+    AsyncEventStats stats = event.Stats();
+    CHECK(stats.posted == 4 && stats.pumped == 4 && stats.dropped == 2);
+    CHECK(stats.peakDepth == 4);
+  }
+
+  void DropOldest()
+  {
+    AsyncEvent<void(int)> event(4, EventOverflow::DropOldest);
+    std::vector<int> seen;
+    event.Hook([&seen](int value) { seen.push_back(value); });
+    for (int i = 0; i < 6; ++i)
+      CHECK(event.Post(i));
+    CHECK(event.QueueDepth() == 4);
+
+    CHECK(event.Pump() == 4);
+    CHECK((seen == std::vector<int>{ 2, 3, 4, 5 }));
+
+    AsyncEventStats stats = event.Stats();
+    CHECK(stats.posted == 6 && stats.pumped == 4 && stats.dropped == 2);
+    CHECK(stats.peakDepth == 4);
+  }
+
+  void PumpLimitAndDiscard()
+  {
+    int destroyed = 0;
+    struct Counted
+    {
+      int *destroyed;
+      explicit Counted(int *destroyed) : destroyed(destroyed) {}
+      Counted(const Counted &other) : destroyed(other.destroyed) {}
+      ~Counted() { ++*destroyed; }
+    };
+
+    {
+      AsyncEvent<void(Counted)> event(8);
+      int calls = 0;
+      event.Hook([&calls](Counted) { ++calls; });
+      for (int i = 0; i < 5; ++i)
+        event.Post(Counted(&destroyed));
+      CHECK(event.Pump(2) == 2);
+      CHECK(calls == 2);
+      CHECK(event.QueueDepth() == 3);
+      destroyed = 0;
+    }
+    // The destructor destroys the three invokes still queued
+    CHECK(destroyed == 3);
+  }
+}
+
+int main()
+{
+  ManyProducersOnePumper();
+  Block();
+  DropNewest();
+  DropOldest();
+  PumpLimitAndDiscard();
+  return test::Result();
+}
@@ -0,0 +1,188 @@
+/*!
+ * \file CoalescedEvent.cpp
+ * \brief
+ *      CoalescedEvent keeps the latest arguments per key, or reduces them, and flushes once per
+ *      key in the order the keys were first posted, within its capacity, reusing its storage
+ *      between flushes.
+ */
+#include "Events.hpp"
+#include "Test.hpp"
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  void LatestValue()
+  {
+    CoalescedEvent<void(float, float)> motion;
+    std::vector<std::pair<float, float>> seen;
+    motion.Hook([&seen](float x, float y) { seen.emplace_back(x, y); });
+
+    CHECK(!motion.Post(1.0f, 2.0f));
+    for (int i = 0; i < 999; ++i)
+      CHECK(motion.Post(float(i), -float(i)));
+    CHECK(motion.PendingCount() == 1);
+    CHECK(seen.empty());
+
+    CHECK(motion.Flush() == 1);
+    CHECK((seen == std::vector<std::pair<float, float>>{ { 998.0f, -998.0f } }));
+    CHECK(motion.Flush() == 0);
+
+    CoalescedEventStats stats = motion.Stats();
+    CHECK(stats.posted == 1000);
+    CHECK(stats.coalesced == 999);
+    CHECK(stats.flushed == 1);
+    CHECK(stats.peakKeys == 1);
+  }
+
+  void KeysReplaceAndKeepOrder()
+  {
+    CoalescedEvent<void(int, const std::string&), int> replicated;
+    std::vector<std::string> seen;
+    replicated.Hook([&seen](int id, const std::string &state) { seen.push_back(std::to_string(id) + state); });
+
+    replicated.Post(3, 3, "a");
+    replicated.Post(1, 1, "b");
+    replicated.Post(3, 3, "c");
+    replicated.Post(2, 2, "d");
+    replicated.Post(1, 1, "e");
+    CHECK(replicated.PendingCount() == 3);
+
+    // Flushed in the order each key was first posted, with its latest arguments
+    CHECK(replicated.Flush() == 3);
+    CHECK((seen == std::vector<std::string>{ "3c", "1e", "2d" }));
+    CHECK(replicated.Stats().coalesced == 2);
+
+    // Keys start over after a flush
+    seen.clear();
+    replicated.Post(2, 2, "f");
+    replicated.Post(3, 3, "g");
+    replicated.Flush();
+    CHECK((seen == std::vector<std::string>{ "2f", "3g" }));
+  }
+
+  void Reducer()
+  {
+    CoalescedEvent<void(int, int), int> scores;
+    scores.SetReducer([](auto &pending, auto &posted) { std::get<1>(pending) += std::get<1>(posted); });
+    std::vector<std::pair<int, int>> seen;
+    scores.Hook([&seen](int player, int total) { seen.emplace_back(player, total); });
+
+    for (int i = 1; i <= 10; ++i)
+      scores.Post(i % 2, i % 2, i);
+    scores.Flush();
+    CHECK((seen == std::vector<std::pair<int, int>>{ { 1, 25 }, { 0, 30 } }));
+  }
+
+  void BoundedCapacity()
+  {
+    // Posting a new key with every key taken flushes early, the pending keys never exceed the capacity
+    CoalescedEvent<void(int), int> event(4);
+    std::vector<int> seen;
+    event.Hook([&seen](int value) { seen.push_back(value); });
+
+    for (int i = 0; i < 10; ++i)
+    {
+      event.Post(i, i);
+      CHECK(event.PendingCount() <= event.PendingCapacity());
+    }
+    CHECK((seen == std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7 }));
+    CHECK(event.Stats().overflows == 2);
+    CHECK(event.Stats().peakKeys == 4);
+
+    event.ClearPending();
+    CHECK(event.PendingCount() == 0);
+    CHECK(event.Flush() == 0);
+  }
+
+  size_t allocations = 0; //!< Allocations made by CountingAllocator
+
+  //! Allocator counting its allocations, to check posting reuses the storage of the last flush
+  template<typename T>
+  struct CountingAllocator
+  {
+    using value_type = T;
+    CountingAllocator() = default;
+    template<typename U> CountingAllocator(const CountingAllocator<U>&) {}
+    T* allocate(size_t count) { ++allocations; return std::allocator<T>().allocate(count); }
+    void deallocate(T *pointer, size_t count) { std::allocator<T>().deallocate(pointer, count); }
+    template<typename U> bool operator==(const CountingAllocator<U>&) const { return true; }
+    template<typename U> bool operator!=(const CountingAllocator<U>&) const { return false; }
+  };
+
+  void NoAllocationPerKey()
+  {
+    CoalescedEvent<void(int), int, true, CountingAllocator<Call<void(int)>>> event(1000);
+    int sum = 0;
+    event.Hook([&sum](int value) { sum += value; });
+    auto frame = [&event]()
+    {
+      for (int key = 0; key < 1000; ++key)
+      {
+        event.Post(key * 7919, 1);
+        event.Post(key * 7919, 2);
+      }
+      return event.Flush();
+    };
+
+    CHECK(frame() == 1000);
+    size_t before = allocations;
+    for (int i = 0; i < 10; ++i)
+      CHECK(frame() == 1000);
+    CHECK(allocations == before);
+    CHECK(sum == 2 * 1000 * 11);
+  }
+
+  void StringKeys()
+  {
+    CoalescedEvent<void(std::string, int), std::string> event(64);
+    std::map<std::string, int> seen;
+    event.Hook([&seen](const std::string &name, int value) { seen[name] = value; });
+    for (int round = 0; round < 3; ++round)
+      for (int i = 0; i < 64; ++i)
+        CHECK(event.Post("key" + std::to_string(i), "key" + std::to_string(i), i * 10 + round) == (round != 0));
+
+    CHECK(event.PendingCount() == 64);
+    CHECK(event.Flush() == 64);
+    bool latest = seen.size() == 64;
+    for (int i = 0; i < 64; ++i)
+      latest = latest && seen["key" + std::to_string(i)] == i * 10 + 2;
+    CHECK(latest);
+    CHECK(event.Stats().coalesced == 128);
+
+    // Keys of the last flush are no longer pending
+    CHECK(!event.Post("key0", "key0", 1));
+  }
+
+  void PostDuringFlush()
+  {
+    // Posts made by callbacks wait for the next flush
+    CoalescedEvent<void(int), int> event;
+    std::vector<int> seen;
+    event.Hook([&](int value)
+    {
+      seen.push_back(value);
+      if (value < 3) event.Post(value, value + 1);
+    });
+
+    event.Post(0, 0);
+    CHECK(event.Flush() == 1);
+    CHECK(event.PendingCount() == 1);
+    while (event.Flush()) {}
+    CHECK((seen == std::vector<int>{ 0, 1, 2, 3 }));
+  }
+}
+
+int main()
+{
+  LatestValue();
+  KeysReplaceAndKeepOrder();
+  Reducer();
+  BoundedCapacity();
+  PostDuringFlush();
+  NoAllocationPerKey();
+  StringKeys();
+  return test::Result();
+}
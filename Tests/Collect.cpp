@@ -0,0 +1,120 @@
+/*!
+ * \file Collect.cpp
+ * \brief
+ *      InvokeUntil and InvokeCollect with the built-in collectors, stopping at the first
+ *      result the predicate or collector accepts.
+ */
+#include "Events.hpp"
+#include "Test.hpp"
+#include <vector>
+
+namespace
+{
+  std::vector<int> calls; //!< Results of the callbacks called, in call order
+
+  //! Hooks callbacks returning each of the values, in order
+  void HookValues(Event<int()> &event, std::vector<int> values)
+  {
+    for (int value : values)
+      event.Hook([value]() { calls.push_back(value); return value; });
+  }
+
+  void InvokeUntilStops()
+  {
+    Event<int()> event;
+    HookValues(event, { 1, 2, 3, 4 });
+
+    calls.clear();
+    CHECK(event.InvokeUntil([](int result) { return result == 2; }));
+    CHECK((calls == std::vector<int>{ 1, 2 }));
+
+    calls.clear();
+    CHECK(!event.InvokeUntil([](int result) { return result > 10; }));
+    CHECK((calls == std::vector<int>{ 1, 2, 3, 4 }));
+  }
+
+  void InvokeUntilVoid()
+  {
+    // Events returning void call the predicate with nothing after each callback
+    Event<void(int&)> event;
+    for (int i = 0; i < 5; ++i)
+      event.Hook([](int &handled) { ++handled; });
+
+    int handled = 0;
+    CHECK(event.InvokeUntil([&handled]() { return handled == 3; }, handled));
+    CHECK(handled == 3);
+  }
+
+  void CollectorsShortCircuit()
+  {
+    Event<int()> event;
+    HookValues(event, { 5, -2, 9, 0 });
+
+    calls.clear();
+    CollectFirst<int> first;
+    CHECK(event.InvokeCollect(first));
+    CHECK(first.value == 5 && first.count == 1);
+    CHECK((calls == std::vector<int>{ 5 }));
+
+    calls.clear();
+    CollectLast<int> last;
+    CHECK(!event.InvokeCollect(last));
+    CHECK(last.value == 0 && last.count == 4);
+    CHECK(calls.size() == 4);
+
+    CollectSum<int> sum(100);
+    CHECK(!event.InvokeCollect(sum));
+    CHECK(sum.value == 112);
+
+    CollectMin<int> min;
+    CollectMax<int> max;
+    event.InvokeCollect(min);
+    event.InvokeCollect(max);
+    CHECK(min.value == -2 && min.count == 4);
+    CHECK(max.value == 9 && max.count == 4);
+
+    // Stops at the first non-zero result
+    calls.clear();
+    CollectAnyTrue any;
+    CHECK(event.InvokeCollect(any));
+    CHECK(any.value);
+    CHECK((calls == std::vector<int>{ 5 }));
+  }
+
+  void CollectorsEmpty()
+  {
+    Event<int()> event;
+    CollectFirst<int> first;
+    CollectAnyTrue any;
+    CollectMax<int> max;
+    CHECK(!event.InvokeCollect(first));
+    CHECK(!event.InvokeCollect(any));
+    CHECK(!event.InvokeCollect(max));
+    CHECK(first.count == 0 && !any.value && max.count == 0);
+  }
+
+  void UnhookWhileCollecting()
+  {
+    // Unhooks made by a callback apply once the collect finishes
+    Event<int()> event;
+    EVENT_HANDLE second = 0;
+    event.Hook([&]() { event.Unhook(second); return 1; });
+    second = event.Hook([]() { return 2; });
+    event.Hook([]() { return 3; });
+
+    CollectSum<int> sum;
+    event.InvokeCollect(sum);
+    CHECK(sum.value == 4);
+    CHECK(event.CallListSize() == 2);
+  }
+}
+
+int main()
+{
+  InvokeUntilStops();
+  InvokeUntilVoid();
+  CollectorsShortCircuit();
+  CollectorsEmpty();
+  UnhookWhileCollecting();
+  return test::Result();
+}
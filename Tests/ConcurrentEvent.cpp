@@ -0,0 +1,84 @@
+/*!
+ * \file ConcurrentEvent.cpp
+ * \brief
+ *      ConcurrentEvent readers hold an epoch slot only while inside an invoke, so more threads
+ *      than EVENT_EPOCH_MAX_THREADS can stay alive and keep invoking, and nested invokes reuse
+ *      the slot of the outermost one.
+ */
+#define EVENT_EPOCH_MAX_THREADS 4
+#include "Events.hpp"
+#include "Test.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  constexpr size_t ThreadCount = EventEpoch::MaxThreads * 4; //!< Threads alive at once
+
+  void MoreThreadsThanSlots()
+  {
+    ConcurrentEvent<void(int)> event;
+    std::atomic<int> sum{0};
+    std::atomic<size_t> invoked{0};
+    uint64_t reads = event.Stats().reads;
+    event.Hook([&sum](int value) { sum += value; });
+
+    // Every thread invokes, then stays alive until all of them have invoked
+    auto reader = [&]() {
+      event.Invoke(1);
+      ++invoked;
+      while (invoked.load() < ThreadCount) std::this_thread::yield();
+      event.Invoke(1);
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < ThreadCount; ++i)
+      threads.emplace_back(reader);
+    for (std::thread &thread : threads)
+      thread.join();
+
+    CHECK(sum.load() == int(ThreadCount * 2));
+    // Reads entered on a shared slot are kept, not lost when another thread claims it
+    CHECK(event.Stats().reads - reads >= ThreadCount * 2);
+  }
+
+  void NestedInvoke()
+  {
+    ConcurrentEvent<void(int)> event;
+    int calls = 0;
+    event.Hook([&](int depth) {
+      ++calls;
+      if (depth < int(EventEpoch::MaxThreads) * 2) event.Invoke(depth + 1);
+    });
+    event.Invoke(1);
+    CHECK(calls == int(EventEpoch::MaxThreads) * 2);
+  }
+
+  void ReclaimAfterReadersLeave()
+  {
+    ConcurrentEvent<void()> event;
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < ThreadCount; ++i)
+      threads.emplace_back([&]() { while (!stop.load()) event.Invoke(); });
+
+    for (int i = 0; i < 100; ++i)
+      event.Hook([]() {});
+    stop = true;
+    for (std::thread &thread : threads)
+      thread.join();
+
+    event.Reclaim();
+    CHECK(event.Stats().pending == 0);
+    CHECK(event.CallListSize() == 100);
+  }
+}
+
+int main()
+{
+  MoreThreadsThanSlots();
+  NestedInvoke();
+  ReclaimAfterReadersLeave();
+  return test::Result();
+}
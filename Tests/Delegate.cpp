@@ -0,0 +1,165 @@
+/*!
+ * \file Delegate.cpp
+ * \brief
+ *      Delegate stores callables that fit in its three pointers in place without allocating,
+ *      places larger ones in the default EventPool, and copies, moves and destroys both kinds
+ *      exactly once each.
+ */
+#include "Events.hpp"
+#include "Test.hpp"
+#include <array>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  using Small = Delegate<int(int)>;
+
+  int live = 0;   //!< Tracked callables alive
+  int copies = 0; //!< Tracked callables copy constructed
+  int moves = 0;  //!< Tracked callables move constructed
+
+  void ResetCounts()
+  {
+    live = copies = moves = 0;
+  }
+
+  //! Callable counting its copies, moves and destructions, padded to 'Size' bytes
+  template<size_t Size>
+  struct Tracked
+  {
+    int offset;
+    std::array<char, Size - sizeof(int)> padding{};
+
+    explicit Tracked(int offset) : offset(offset) { ++live; }
+    Tracked(const Tracked &other) : offset(other.offset), padding(other.padding) { ++live; ++copies; }
+    Tracked(Tracked &&other) noexcept : offset(other.offset), padding(other.padding) { ++live; ++moves; }
+    ~Tracked() { --live; }
+    int operator()(int x) const { return x + offset; }
+  };
+
+  using InlineTracked = Tracked<sizeof(void*) * 2>;
+  using PooledTracked = Tracked<sizeof(void*) * 8>;
+
+  int Twice(int x) { return x * 2; }
+
+  static_assert(Small::Capacity == sizeof(void*) * 3);
+  static_assert(sizeof(InlineTracked) <= Small::Capacity);
+  static_assert(sizeof(PooledTracked) > Small::Capacity);
+
+  void InlineDoesNotAllocate()
+  {
+    // 30000 delegates would take several new chunks if any of them were placed in the pool
+    int base = 3;
+    long wide = 4;
+    std::vector<Small> delegates;
+    delegates.reserve(30000);
+    EventPoolStats before = EventPool::Default().Stats();
+
+    for (int i = 0; i < 10000; ++i)
+    {
+      delegates.emplace_back(&Twice);
+      delegates.emplace_back([base](int x) { return x + base; });
+      delegates.emplace_back([&base, wide, i](int x) { return x + base + int(wide) + i; });
+    }
+    long long sum = 0;
+    for (const Small &delegate : delegates)
+      sum += delegate(1);
+    std::vector<Small> copied(delegates);
+    std::vector<Small> moved(std::move(copied));
+    moved.clear();
+
+    EventPoolStats after = EventPool::Default().Stats();
+    CHECK(after.chunks == before.chunks);
+    CHECK(after.largeAllocations == before.largeAllocations);
+    CHECK(sum == 10000LL * (2 + 4 + 8) + 9999LL * 10000 / 2);
+  }
+
+  void OversizedUsesPool()
+  {
+    EventPoolStats before = EventPool::Default().Stats();
+    std::array<uint64_t, 8> data{ 1, 2, 3, 4, 5, 6, 7, 8 };
+    std::vector<Small> delegates;
+    delegates.reserve(20000);
+    for (int i = 0; i < 20000; ++i)
+      delegates.emplace_back([data](int x) { return x + int(data[7]); });
+
+    // 20000 blocks of 64 bytes do not fit in the chunks the pool already had, or its thread cache
+    CHECK(EventPool::Default().Stats().chunks > before.chunks);
+    CHECK(delegates.back()(1) == 9);
+
+    // Too large for any size class, passed to the system through the pool
+    std::array<uint64_t, 256> huge{};
+    huge[0] = 5;
+    Small large([huge](int x) { return x + int(huge[0]); });
+    CHECK(EventPool::Default().Stats().largeAllocations == before.largeAllocations + 1);
+    CHECK(large(1) == 6);
+  }
+
+  template<typename Fn>
+  void CopyMoveDestroy()
+  {
+    ResetCounts();
+    {
+      Small first{ Fn(10) };
+      CHECK(live == 1);
+      CHECK(first(1) == 11);
+      CHECK(first.template target<Fn>() != nullptr);
+
+      Small copy(first);
+      CHECK(live == 2 && copies == 1);
+      CHECK(copy(1) == 11 && copy.template target<Fn>() != first.template target<Fn>());
+
+      int movesBefore = moves;
+      Small moved(std::move(first));
+      CHECK(!first && moved);
+      CHECK(live == 2);
+      CHECK(moved(2) == 12);
+      // Inline callables are move constructed into place, pooled ones change owner by pointer
+      CHECK(moves == movesBefore + (sizeof(Fn) <= Small::Capacity ? 1 : 0));
+
+      Small assigned{ Fn(20) };
+      assigned = copy;
+      CHECK(live == 3 && assigned(1) == 11);
+      assigned = std::move(moved);
+      CHECK(live == 2 && !moved && assigned(1) == 11);
+
+      // Replaced by a callable of the other kind, and the other way around
+      copy = Small(&Twice);
+      CHECK(live == 1 && copy(4) == 8);
+      copy = assigned;
+      CHECK(live == 2 && copy(4) == 14);
+
+      assigned.Reset();
+      CHECK(live == 1 && !assigned);
+      const Small &self = assigned;
+      assigned = self;
+      CHECK(!assigned);
+    }
+    CHECK(live == 0);
+  }
+
+  void PooledBlocksAreReused()
+  {
+    // Freed blocks go back to the pool, so constructing and destroying in a loop stops growing it
+    for (int i = 0; i < 1000; ++i) { Small warm{ PooledTracked(i) }; }
+    EventPoolStats before = EventPool::Default().Stats();
+    for (int i = 0; i < 100000; ++i)
+    {
+      Small delegate{ PooledTracked(i) };
+      Small copy(delegate);
+    }
+    CHECK(EventPool::Default().Stats().chunks == before.chunks);
+    CHECK(live == 0);
+  }
+}
+
+int main()
+{
+  InlineDoesNotAllocate();
+  OversizedUsesPool();
+  CopyMoveDestroy<InlineTracked>();
+  CopyMoveDestroy<PooledTracked>();
+  PooledBlocksAreReused();
+  return test::Result();
+}
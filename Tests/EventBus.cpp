@@ -0,0 +1,135 @@
+/*!
+ * \file EventBus.cpp
+ * \brief
+ *      EventBus keeps one event per message type, adds it on first Get only, gives every type
+ *      the same index in every translation unit and thread, and reports its events, callbacks
+ *      and bytes.
+ */
+#include "EventBus.hpp"
+#include "Test.hpp"
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  struct Spawned { int id; float x; }; //!< Message published from constructor arguments
+  struct Unused {};                     //!< Message no one hooks
+
+  template<size_t I>
+  struct Tag { size_t value; }; //!< Distinct message types first used by several threads at once
+
+  void GetFindPublish()
+  {
+    EventBus bus;
+    CHECK(bus.Find<bus::Damage>() == nullptr);
+
+    // Publish without an event does nothing and adds none
+    bus.Publish(bus::Damage{ 5 });
+    bus.Publish<Spawned>(1, 2.0f);
+    CHECK(bus.Find<bus::Damage>() == nullptr);
+    CHECK(bus.Stats().events == 0);
+
+    int damage = 0;
+    std::vector<std::pair<int, float>> spawned;
+    bus.Get<bus::Damage>().Hook([&damage](const bus::Damage &msg) { damage += msg.amount; });
+    bus.Get<Spawned>().Hook([&spawned](const Spawned &msg) { spawned.emplace_back(msg.id, msg.x); });
+    CHECK(bus.Find<bus::Damage>() == &bus.Get<bus::Damage>());
+    CHECK(bus.Find<Unused>() == nullptr);
+
+    bus.Publish(bus::Damage{ 5 });
+    bus.Publish<bus::Damage>(bus::Damage{ 7 });
+    bus.Publish<Spawned>(3, 4.5f);
+    CHECK(damage == 12);
+    CHECK((spawned == std::vector<std::pair<int, float>>{ { 3, 4.5f } }));
+
+    // Buses do not share events
+    EventBus other;
+    other.Publish(bus::Damage{ 100 });
+    CHECK(damage == 12);
+    CHECK(other.Find<bus::Damage>() == nullptr);
+  }
+
+  void SameIndexAcrossUnits()
+  {
+    EventBus bus;
+    int damage = 0;
+    bus.Get<bus::Damage>().Hook([&damage](const bus::Damage &msg) { damage += msg.amount; });
+    CHECK(bus::DamageEvent(bus) == &bus.Get<bus::Damage>());
+    bus::PublishDamage(bus, 3);
+    CHECK(damage == 3);
+
+    std::string last;
+    bus::HookRenamed(bus, last);
+    bus.Publish(bus::Renamed{ "player" });
+    CHECK(last == "player");
+    CHECK(bus.Stats().events == 2);
+  }
+
+  template<size_t ...I>
+  bool UseTags(std::index_sequence<I...>)
+  {
+    // Each type must reach its own event, a shared index would mix the values up
+    EventBus bus;
+    std::vector<size_t> seen;
+    (bus.Get<Tag<I>>().Hook([&seen](const Tag<I> &msg) { seen.push_back(msg.value + I); }), ...);
+    (bus.Publish(Tag<I>{ I }), ...);
+    bool distinct = bus.Stats().events == sizeof...(I);
+    std::vector<size_t> expected{ (I * 2)... };
+    return distinct && seen == expected;
+  }
+
+  void SameIndexAcrossThreads()
+  {
+    constexpr size_t ThreadCount = 8;
+    std::atomic<size_t> ready{0};
+    std::atomic<size_t> passed{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < ThreadCount; ++i)
+      threads.emplace_back([&]()
+      {
+        ++ready;
+        while (ready.load() < ThreadCount) std::this_thread::yield();
+        if (UseTags(std::make_index_sequence<32>())) ++passed;
+      });
+    for (std::thread &thread : threads)
+      thread.join();
+    CHECK(passed.load() == ThreadCount);
+  }
+
+  void ClearAndStats()
+  {
+    EventBus bus;
+    EventBusStats empty = bus.Stats();
+    CHECK(empty.events == 0 && empty.callbacks == 0);
+
+    int calls = 0;
+    bus.Get<bus::Damage>().Hook([&calls](const bus::Damage&) { ++calls; });
+    bus.Get<bus::Damage>().Hook([&calls](const bus::Damage&) { ++calls; });
+    bus.Get<Spawned>().Hook([&calls](const Spawned&) { ++calls; });
+    bus.Get<Unused>();
+
+    EventBusStats stats = bus.Stats();
+    CHECK(stats.events == 3);
+    CHECK(stats.callbacks == 3);
+    CHECK(stats.bytes > empty.bytes);
+
+    // Clear keeps the events, so they are still found, with no callbacks
+    bus.Clear();
+    CHECK(bus.Stats().events == 3);
+    CHECK(bus.Stats().callbacks == 0);
+    CHECK(bus.Find<bus::Damage>() != nullptr);
+    bus.Publish(bus::Damage{ 1 });
+    CHECK(calls == 0);
+  }
+}
+
+int main()
+{
+  GetFindPublish();
+  SameIndexAcrossUnits();
+  SameIndexAcrossThreads();
+  ClearAndStats();
+  return test::Result();
+}
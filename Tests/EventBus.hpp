@@ -0,0 +1,28 @@
+/*!
+ * \file EventBus.hpp
+ * \brief
+ *      Message types and helpers shared by the two translation units of the EventBus test.
+ */
+#ifndef EVENTS_TEST_EVENT_BUS_HPP
+#define EVENTS_TEST_EVENT_BUS_HPP
+#pragma once
+
+#include "Events.hpp"
+#include <string>
+
+namespace bus
+{
+  struct Damage { int amount; };       //!< Message hooked in one unit and published in the other
+  struct Renamed { std::string name; }; //!< Message only used in the other unit first
+
+  //! Gets the event of Damage from the other translation unit
+  EventBus::EventType<Damage>* DamageEvent(EventBus &bus);
+
+  //! Hooks Renamed from the other translation unit, recording the name into 'last'
+  void HookRenamed(EventBus &bus, std::string &last);
+
+  //! Publishes Damage from the other translation unit
+  void PublishDamage(EventBus &bus, int amount);
+}
+
+#endif // EVENTS_TEST_EVENT_BUS_HPP
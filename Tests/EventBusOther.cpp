@@ -0,0 +1,24 @@
+/*!
+ * \file EventBusOther.cpp
+ * \brief
+ *      Second translation unit of the EventBus test, using the same message types.
+ */
+#include "EventBus.hpp"
+
+namespace bus
+{
+  EventBus::EventType<Damage>* DamageEvent(EventBus &bus)
+  {
+    return bus.Find<Damage>();
+  }
+
+  void HookRenamed(EventBus &bus, std::string &last)
+  {
+    bus.Get<Renamed>().Hook([&last](const Renamed &msg) { last = msg.name; });
+  }
+
+  void PublishDamage(EventBus &bus, int amount)
+  {
+    bus.Publish(Damage{ amount });
+  }
+}
@@ -0,0 +1,176 @@
+/*!
+ * \file EventListener.cpp
+ * \brief
+ *      EventListener unhooks its tracked calls when destroyed, an event destroyed first drops
+ *      its subscriptions so nothing is unhooked twice or through a dangling event, and moved
+ *      events take their subscriptions along.
+ */
+#include "Events.hpp"
+#include "Test.hpp"
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  struct Listener : EventListener
+  {
+    int calls = 0;
+    void Call(int) { ++calls; }
+    void Other(float) { ++calls; }
+  };
+
+  void ListenerDestroyedFirst()
+  {
+    Event<void(int)> event;
+    int others = 0;
+    event.Hook([&others](int) { ++others; });
+    {
+      Listener listener;
+      listener.Listen(event, &Listener::Call);
+      CHECK(listener.SubscriptionCount() == 1);
+      CHECK(event.CallListSize() == 2);
+      event.Invoke(1);
+      CHECK(listener.calls == 1);
+    }
+    CHECK(event.CallListSize() == 1);
+    event.Invoke(1);
+    CHECK(others == 2);
+  }
+
+  void EventDestroyedFirst()
+  {
+    Listener listener;
+    {
+      Event<void(int)> event;
+      listener.Listen(event, &Listener::Call);
+      Event<void(float)> other;
+      listener.Listen(other, &Listener::Other);
+      CHECK(listener.SubscriptionCount() == 2);
+    }
+    // Both events dropped their subscriptions, the listener's destructor touches neither
+    CHECK(listener.SubscriptionCount() == 0);
+    listener.UnhookAll();
+  }
+
+  void UnhookedByHandleFirst()
+  {
+    // A call unhooked by handle and replaced is not unhooked again by the listener
+    Event<void(int)> event;
+    int others = 0;
+    {
+      Listener listener;
+      EVENT_HANDLE handle = listener.Listen(event, &Listener::Call);
+      event.Unhook(handle);
+      event.Hook([&others](int) { ++others; });
+      CHECK(listener.SubscriptionCount() == 1);
+    }
+    CHECK(event.CallListSize() == 1);
+
+    {
+      Listener listener;
+      listener.Listen(event, &Listener::Call);
+      event.Clear();
+      event.Hook([&others](int) { ++others; });
+    }
+    CHECK(event.CallListSize() == 1);
+    event.Invoke(1);
+    CHECK(others == 1);
+  }
+
+  void TrackSeveralEvents()
+  {
+    Event<void(int)> first, second;
+    Event<void(float)> third;
+    Listener listener;
+    listener.Listen(first, &Listener::Call);
+    listener.Listen(second, &Listener::Call);
+    listener.Listen(third, &Listener::Other);
+    listener.Track(first, first.Hook([&listener](int) { listener.calls += 10; }));
+    CHECK(listener.SubscriptionCount() == 4);
+
+    first.Invoke(1);
+    second.Invoke(1);
+    third.Invoke(1.0f);
+    CHECK(listener.calls == 13);
+
+    listener.UnhookAll();
+    CHECK(listener.SubscriptionCount() == 0);
+    CHECK(first.CallListSize() == 0 && second.CallListSize() == 0 && third.CallListSize() == 0);
+
+    // The listener can listen again after UnhookAll
+    listener.Listen(second, &Listener::Call);
+    CHECK(listener.SubscriptionCount() == 1);
+    CHECK(second.CallListSize() == 1);
+  }
+
+  void SeveralListenersOneEvent()
+  {
+    Event<void(int)> event;
+    std::vector<std::unique_ptr<Listener>> listeners;
+    for (int i = 0; i < 8; ++i)
+    {
+      listeners.push_back(std::make_unique<Listener>());
+      listeners.back()->Listen(event, &Listener::Call);
+    }
+
+    // Destroyed out of hook order, from the middle and both ends of the lists
+    listeners[3].reset();
+    listeners[0].reset();
+    listeners[7].reset();
+    CHECK(event.CallListSize() == 5);
+    event.Invoke(1);
+    CHECK(listeners[1]->calls == 1 && listeners[6]->calls == 1);
+
+    listeners.clear();
+    CHECK(event.CallListSize() == 0);
+  }
+
+  void MovedEvent()
+  {
+    auto source = std::make_unique<Event<void(int)>>();
+    Listener listener;
+    listener.Listen(*source, &Listener::Call);
+
+    Event<void(int)> moved(std::move(*source));
+    source.reset();
+    CHECK(listener.SubscriptionCount() == 1);
+    moved.Invoke(1);
+    CHECK(listener.calls == 1);
+
+    Event<void(int)> assigned;
+    assigned = std::move(moved);
+    assigned.Invoke(1);
+    CHECK(listener.calls == 2);
+
+    listener.UnhookAll();
+    CHECK(assigned.CallListSize() == 0);
+    CHECK(listener.SubscriptionCount() == 0);
+  }
+
+  void CopiedListener()
+  {
+    // Copies start with no subscriptions, the calls stay bound to the original
+    Event<void(int)> event;
+    Listener original;
+    original.Listen(event, &Listener::Call);
+    {
+      Listener copy(original);
+      CHECK(copy.SubscriptionCount() == 0);
+    }
+    CHECK(event.CallListSize() == 1);
+    CHECK(original.SubscriptionCount() == 1);
+  }
+}
+
+int main()
+{
+  ListenerDestroyedFirst();
+  EventDestroyedFirst();
+  UnhookedByHandleFirst();
+  TrackSeveralEvents();
+  SeveralListenersOneEvent();
+  MovedEvent();
+  CopiedListener();
+  return test::Result();
+}
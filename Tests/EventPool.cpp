@@ -0,0 +1,104 @@
+/*!
+ * \file EventPool.cpp
+ * \brief
+ *      Events on EventPool allocators reuse freed blocks, thread caches give their blocks back
+ *      when threads exit, and static events allocating from the default pool are destroyed
+ *      after the main thread's cache.
+ */
+#include "Events.hpp"
+#include "Test.hpp"
+#include <array>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  //! Lambda capture too large for a Delegate's in place storage, allocated from the default pool
+  struct Large
+  {
+    std::array<uint64_t, 16> data{};
+    int *counter = nullptr;
+    void operator()(int x) const { *counter += x + int(data[0]); }
+  };
+
+  int staticCalls = 0; //!< Calls made by the static events
+
+  //! Static event destroyed after main returns and after the main thread's cache
+  struct StaticEvents
+  {
+    Event<void(int), true, EventPoolAllocator<Call<void(int)>>> event;
+    std::vector<Delegate<void(int)>> delegates;
+
+    ~StaticEvents()
+    {
+      // Frees and allocates from the default pool during static destruction
+      event.Invoke(1);
+      event.Clear();
+      delegates.clear();
+      Event<void(int)> late;
+      late.Hook(Large{ {}, &staticCalls });
+      late.Invoke(1);
+    }
+  };
+
+  StaticEvents statics;
+
+  void ArenaReuse()
+  {
+    EventPool pool;
+    int calls = 0;
+    {
+      Event<void(int), false, EventPoolAllocator<Call<void(int)>>> event{ EventPoolAllocator<Call<void(int)>>(pool) };
+      std::vector<EVENT_HANDLE> handles;
+      for (int round = 0; round < 100; ++round)
+      {
+        for (int i = 0; i < 64; ++i)
+          handles.push_back(event.Hook(Large{ {}, &calls }));
+        event.Invoke(1);
+        event.UnhookRange(handles.begin(), handles.end());
+        handles.clear();
+      }
+    }
+    CHECK(calls == 6400);
+    // Churn reaches a steady state, the freed blocks are reused
+    CHECK(pool.Stats().chunks <= 2);
+  }
+
+  void ThreadCachesReturnBlocks()
+  {
+    auto churn = []()
+    {
+      int calls = 0;
+      Event<void(int)> event;
+      for (int i = 0; i < 200; ++i)
+        event.Hook(Large{ {}, &calls });
+      event.Invoke(1);
+    };
+
+    // One thread at a time, so the blocks in use do not depend on how the threads overlap
+    std::thread(churn).join();
+    size_t chunks = EventPool::Default().Stats().chunks;
+
+    // Exited threads gave their blocks back, more threads need no new chunks
+    for (int i = 0; i < 32; ++i)
+      std::thread(churn).join();
+    CHECK(EventPool::Default().Stats().chunks == chunks);
+  }
+
+  void FillStatics()
+  {
+    for (int i = 0; i < 100; ++i)
+    {
+      statics.event.Hook(Large{ {}, &staticCalls });
+      statics.delegates.emplace_back(Large{ {}, &staticCalls });
+    }
+  }
+}
+
+int main()
+{
+  ArenaReuse();
+  ThreadCachesReturnBlocks();
+  FillStatics();
+  return test::Result();
+}
@@ -0,0 +1,158 @@
+/*!
+ * \file EventQueue.cpp
+ * \brief
+ *      EventQueue carries out the invokes queued before Dispatch as one batch, callbacks outer,
+ *      keeps its ring buffer between dispatches, and reserves callbacks and queued invokes
+ *      separately.
+ */
+#include "Events.hpp"
+#include "Test.hpp"
+#include <string>
+#include <vector>
+
+namespace
+{
+  void DispatchQueued()
+  {
+    EventQueue<void(int, std::string)> queue;
+    std::vector<std::string> seen;
+    queue.Hook([&seen](int id, const std::string &name) { seen.push_back(std::to_string(id) + name); });
+
+    queue.Enqueue(1, "a");
+    queue.Enqueue(2, "b");
+    CHECK(queue.QueueDepth() == 2);
+    CHECK(seen.empty());
+
+    CHECK(queue.Dispatch() == 2);
+    CHECK((seen == std::vector<std::string>{ "1a", "2b" }));
+    CHECK(queue.QueueDepth() == 0);
+    CHECK(queue.Dispatch() == 0);
+  }
+
+  void EnqueueDuringDispatch()
+  {
+    // Invokes queued by callbacks wait for the next dispatch, even when the buffer grows
+    EventQueue<void(int)> queue;
+    std::vector<int> seen;
+    queue.Hook([&](int value)
+    {
+      seen.push_back(value);
+      if (value < 3)
+        for (int i = 0; i < 40; ++i)
+          queue.Enqueue(value + 1);
+    });
+
+    queue.Enqueue(0);
+    CHECK(queue.Dispatch() == 1);
+    CHECK(queue.QueueDepth() == 40);
+    CHECK(queue.Dispatch() == 40);
+    CHECK(seen.size() == 41);
+  }
+
+  void CallbacksOuter()
+  {
+    EventQueue<void(int)> queue;
+    std::vector<std::string> seen;
+    queue.Hook([&seen](int value) { seen.push_back("a" + std::to_string(value)); });
+    queue.Hook([&seen](int value) { seen.push_back("b" + std::to_string(value)); });
+    for (int i = 0; i < 3; ++i)
+      queue.Enqueue(i);
+
+    CHECK(queue.Dispatch() == 3);
+    CHECK((seen == std::vector<std::string>{ "a0", "a1", "a2", "b0", "b1", "b2" }));
+  }
+
+  void HookAndUnhookDuringDispatch()
+  {
+    EventQueue<void(int)> queue;
+    std::vector<std::string> seen;
+    EVENT_HANDLE later = EVENT_HANDLE(0);
+    EVENT_HANDLE second = EVENT_HANDLE(0);
+    queue.Hook([&](int value)
+    {
+      seen.push_back("a" + std::to_string(value));
+      if (value == 0)
+        later = queue.Hook([&seen](int v) { seen.push_back("c" + std::to_string(v)); });
+      if (value == 1)
+        queue.Unhook(second);
+    });
+    second = queue.Hook([&seen](int value) { seen.push_back("b" + std::to_string(value)); });
+    queue.Enqueue(0);
+    queue.Enqueue(1);
+
+    // Hooked during the dispatch starts at the next one, unhooked is never reached
+    queue.Dispatch();
+    CHECK((seen == std::vector<std::string>{ "a0", "a1" }));
+
+    seen.clear();
+    queue.Enqueue(2);
+    queue.Dispatch();
+    CHECK((seen == std::vector<std::string>{ "a2", "c2" }));
+    CHECK(later != EVENT_HANDLE(0));
+  }
+
+  void DispatchFromCallback()
+  {
+    EventQueue<void(int)> queue;
+    std::vector<int> seen;
+    queue.Hook([&](int value)
+    {
+      seen.push_back(value);
+      if (value == 0)
+      {
+        queue.Enqueue(10);
+        CHECK(queue.Dispatch() == 1);
+      }
+    });
+    queue.Enqueue(0);
+    queue.Enqueue(1);
+
+    CHECK(queue.Dispatch() == 2);
+    CHECK((seen == std::vector<int>{ 0, 10, 1 }));
+    CHECK(queue.QueueDepth() == 0);
+  }
+
+  void NonConstReference()
+  {
+    // Payloads are handed to InvokeBatch as const, these dispatch one invoke at a time
+    EventQueue<void(int&)> queue;
+    int total = 0;
+    queue.Hook([](int &value) { value *= 2; });
+    queue.Hook([&total](int &value) { total += value; });
+    queue.Enqueue(1);
+    queue.Enqueue(2);
+
+    CHECK(queue.Dispatch() == 2);
+    CHECK(total == 6);
+  }
+
+  void ReserveQueueAndCallbacks()
+  {
+    EventQueue<void(int)> queue;
+    queue.ReserveQueue(100);
+    CHECK(queue.QueueCapacity() == 128);
+    for (int i = 0; i < 100; ++i)
+      queue.Enqueue(i);
+    CHECK(queue.QueueCapacity() == 128);
+    queue.ClearQueue();
+    CHECK(queue.QueueCapacity() == 128);
+
+    // Reserve is Event::Reserve, making room for callbacks and leaving the ring buffer alone
+    size_t bytes = queue.MemoryUsage();
+    queue.Reserve(1000);
+    CHECK(queue.MemoryUsage() > bytes);
+    CHECK(queue.QueueCapacity() == 128);
+  }
+}
+
+int main()
+{
+  DispatchQueued();
+  EnqueueDuringDispatch();
+  CallbacksOuter();
+  HookAndUnhookDuringDispatch();
+  DispatchFromCallback();
+  NonConstReference();
+  ReserveQueueAndCallbacks();
+  return test::Result();
+}
@@ -0,0 +1,94 @@
+/*!
+ * \file Hook.cpp
+ * \brief
+ *      Hooking free functions, member functions and lambdas, the handles returned and Clear.
+ */
+#include "Events.hpp"
+#include "Test.hpp"
+#include <vector>
+
+namespace
+{
+  std::vector<int> calls; //!< Arguments each callback was called with, in call order
+
+  void Free(int x) { calls.push_back(x); }
+  void Other(int x) { calls.push_back(x + 100); }
+
+  struct Object
+  {
+    int value = 0;
+    void Add(int x) { value += x; }
+    void Set(int x) const { calls.push_back(x + 1000); }
+  };
+
+  template<bool Ordered>
+  void HookEachKind()
+  {
+    calls.clear();
+    Event<void(int), Ordered> event;
+    Object object;
+    int lambda = 0;
+
+    EVENT_HANDLE free = event.Hook(Free);
+    EVENT_HANDLE member = event.Hook(object, &Object::Add);
+    EVENT_HANDLE constMember = event.Hook(object, &Object::Set);
+    EVENT_HANDLE captured = event.Hook([&lambda](int x) { lambda += x; });
+    CHECK(event.CallListSize() == 4);
+    CHECK(free != member && member != constMember && constMember != captured && free != captured);
+    CHECK(!GET_CLUSTER(free) && !GET_CLUSTER(member) && !GET_CLUSTER(captured));
+
+    event.Invoke(2);
+    event.Invoke(3);
+    CHECK(object.value == 5);
+    CHECK(lambda == 5);
+    CHECK(calls.size() == 4);
+
+    event.Clear();
+    CHECK(event.CallListSize() == 0);
+    event.Invoke(4);
+    CHECK(object.value == 5 && lambda == 5 && calls.size() == 4);
+  }
+
+  void HookDuplicates()
+  {
+    // Ordered events may hold the same function more than once, each hook is called
+    calls.clear();
+    Event<void(int)> event;
+    event.Hook(Free);
+    event.Hook(Free);
+    event.Hook(Other);
+    event.Invoke(1);
+    CHECK((calls == std::vector<int>{ 1, 1, 101 }));
+  }
+
+  void HookReturning()
+  {
+    Event<int(int)> event;
+    event.Hook([](int x) { return x * 2; });
+    CollectSum<int> sum;
+    event.InvokeCollect(sum, 5);
+    CHECK(sum.value == 10);
+  }
+
+  void HookAfterClear()
+  {
+    // Slots freed by Clear are reused, the old handles stay stale
+    Event<void(int)> event;
+    EVENT_HANDLE old = event.Hook(Free);
+    event.Clear();
+    EVENT_HANDLE reused = event.Hook(Other);
+    CHECK(old != reused);
+    event.Unhook(old);
+    CHECK(event.CallListSize() == 1);
+  }
+}
+
+int main()
+{
+  HookEachKind<true>();
+  HookEachKind<false>();
+  HookDuplicates();
+  HookReturning();
+  HookAfterClear();
+  return test::Result();
+}
@@ -0,0 +1,122 @@
+/*!
+ * \file HookOnce.cpp
+ * \brief
+ *      HookOnce callbacks run for one invoke only, and while any is hooked the other callbacks
+ *      keep their order, move-to-last and profiling. Built twice, once with EVENT_PROFILE.
+ */
+#include "Events.hpp"
+#include "Test.hpp"
+#include <vector>
+
+namespace
+{
+  std::vector<int> calls; //!< Ids of the callbacks called, in call order
+
+  template<typename E>
+  std::vector<int> Called(E &event)
+  {
+    calls.clear();
+    event.Invoke();
+    return calls;
+  }
+
+  //! Argument counting its copies
+  struct Counted
+  {
+    static inline int copies = 0;
+
+    Counted() = default;
+    Counted(const Counted&) { ++copies; }
+    Counted(Counted&&) noexcept {}
+    Counted& operator=(const Counted&) { ++copies; return *this; }
+    Counted& operator=(Counted&&) noexcept { return *this; }
+  };
+
+  void OnceOnly()
+  {
+    Event<void()> event;
+    event.Hook([]() { calls.push_back(1); });
+    EVENT_HANDLE once = event.HookOnce([]() { calls.push_back(2); });
+    event.Hook([]() { calls.push_back(3); });
+    CHECK(event.CallListSize() == 3);
+
+    CHECK((Called(event) == std::vector<int>{ 1, 2, 3 }));
+    CHECK((Called(event) == std::vector<int>{ 1, 3 }));
+    CHECK(event.CallListSize() == 2);
+
+    // The handle is stale once invoked
+    event.Unhook(once);
+    CHECK(event.CallListSize() == 2);
+  }
+
+  void OnceHookedDuringInvoke()
+  {
+    // A one-shot callback hooked by a callback runs on the next invoke, not this one
+    Event<void()> event;
+    bool hooked = false;
+    event.Hook([&]()
+    {
+      calls.push_back(1);
+      if (!hooked) event.HookOnce([]() { calls.push_back(2); });
+      hooked = true;
+    });
+    CHECK((Called(event) == std::vector<int>{ 1 }));
+    CHECK((Called(event) == std::vector<int>{ 1, 2 }));
+    CHECK((Called(event) == std::vector<int>{ 1 }));
+  }
+
+  void OnceWithMoveToLast()
+  {
+    constexpr int Callbacks = 4;
+    Event<void(Counted)> event;
+    event.SetMoveToLast(true);
+    event.HookOnce([](Counted) {});
+    for (int i = 1; i < Callbacks; ++i)
+      event.Hook([](Counted) {});
+
+    // The last callback takes the argument by move while a one-shot callback is hooked
+    Counted::copies = 0;
+    event.Invoke(Counted());
+    CHECK(Counted::copies == Callbacks - 1);
+
+    Counted::copies = 0;
+    event.Invoke(Counted());
+    CHECK(Counted::copies == Callbacks - 2);
+
+    // Also when the last callback is the one-shot one
+    event.HookOnce([](Counted) {});
+    Counted::copies = 0;
+    event.Invoke(Counted());
+    CHECK(Counted::copies == Callbacks - 1);
+  }
+
+#ifdef EVENT_PROFILE
+  void OnceWithProfile()
+  {
+    Event<void()> event;
+    EVENT_HANDLE kept = event.Hook([]() { calls.push_back(1); });
+    event.HookOnce([]() { calls.push_back(2); });
+    EVENT_HANDLE after = event.Hook([]() { calls.push_back(3); });
+
+    Called(event);
+    CHECK(event.Profile(kept) && event.Profile(kept)->count == 1);
+    CHECK(event.Profile(after) && event.Profile(after)->count == 1);
+
+    event.HookOnce([]() { calls.push_back(4); });
+    Called(event);
+    CHECK(event.Profile(kept)->count == 2);
+    CHECK(event.Profile(after)->count == 2);
+  }
+#endif
+}
+
+int main()
+{
+  OnceOnly();
+  OnceHookedDuringInvoke();
+  OnceWithMoveToLast();
+#ifdef EVENT_PROFILE
+  OnceWithProfile();
+#endif
+  return test::Result();
+}
@@ -0,0 +1,108 @@
+/*!
+ * \file HookRange.cpp
+ * \brief
+ *      HookRange, UnhookRange and Reserve, including from a callback during an invoke, which
+ *      must not reallocate the call list being invoked.
+ */
+#include "Events.hpp"
+#include "Test.hpp"
+#include <functional>
+#include <iterator>
+#include <list>
+#include <vector>
+
+namespace
+{
+  struct Object
+  {
+    int value = 0;
+    void Add(int x) { value += x; }
+  };
+
+  void HookRangeOfCallbacks()
+  {
+    Event<void(int)> event;
+    int sum = 0;
+    std::vector<std::function<void(int)>> callbacks;
+    for (int i = 0; i < 10; ++i)
+      callbacks.emplace_back([&sum, i](int x) { sum += x * i; });
+
+    std::vector<EVENT_HANDLE> handles;
+    event.HookRange(callbacks.begin(), callbacks.end(), std::back_inserter(handles));
+    CHECK(handles.size() == 10);
+    CHECK(event.CallListSize() == 10);
+    event.Invoke(1);
+    CHECK(sum == 45);
+
+    event.UnhookRange(handles.begin(), handles.begin() + 5);
+    CHECK(event.CallListSize() == 5);
+    sum = 0;
+    event.Invoke(1);
+    CHECK(sum == 35);
+  }
+
+  void HookRangeOfObjects()
+  {
+    Event<void(int)> event;
+    std::list<Object> objects(4);
+    std::vector<Object*> pointers;
+    for (Object &object : objects)
+      pointers.push_back(&object);
+
+    std::vector<EVENT_HANDLE> handles;
+    event.HookRange(objects.begin(), objects.end(), &Object::Add, std::back_inserter(handles));
+    event.HookRange(pointers.begin(), pointers.end(), &Object::Add, std::back_inserter(handles));
+    CHECK(handles.size() == 8);
+    event.Invoke(2);
+    for (const Object &object : objects)
+      CHECK(object.value == 4);
+
+    // Handles already unhooked are skipped
+    event.UnhookRange(handles.begin(), handles.end());
+    event.UnhookRange(handles.begin(), handles.end());
+    CHECK(event.CallListSize() == 0);
+  }
+
+  void HookRangeDuringInvoke()
+  {
+    // Grows the event from inside a callback, the invoke keeps reading the call list it started with
+    Event<void(int)> event;
+    int called = 0;
+    std::vector<std::function<void(int)>> callbacks(1000, [&called](int) { ++called; });
+    std::vector<EVENT_HANDLE> handles;
+    bool hooked = false;
+    event.Hook([&](int)
+    {
+      if (hooked) return;
+      hooked = true;
+      event.Reserve(100000);
+      event.HookRange(callbacks.begin(), callbacks.end(), std::back_inserter(handles));
+    });
+    for (int i = 0; i < 3; ++i)
+      event.Hook([&called](int) { ++called; });
+
+    event.Invoke(0);
+    CHECK(called == 3);
+    CHECK(handles.size() == 1000);
+    CHECK(event.CallListSize() == 1004);
+
+    called = 0;
+    event.Invoke(0);
+    CHECK(called == 1003);
+
+    // Unhooking the range from inside a callback too
+    event.Hook([&](int) { event.UnhookRange(handles.begin(), handles.end()); });
+    called = 0;
+    event.Invoke(0);
+    CHECK(called == 1003);
+    CHECK(event.CallListSize() == 5);
+  }
+}
+
+int main()
+{
+  HookRangeOfCallbacks();
+  HookRangeOfObjects();
+  HookRangeDuringInvoke();
+  return test::Result();
+}
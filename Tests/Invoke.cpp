@@ -0,0 +1,124 @@
+/*!
+ * \file Invoke.cpp
+ * \brief
+ *      Hooking, unhooking and clearing from callbacks during an invoke, and nested invokes.
+ */
+#include "Events.hpp"
+#include "Test.hpp"
+#include <vector>
+
+namespace
+{
+  std::vector<int> calls; //!< Ids of the callbacks called, in call order
+
+  template<typename E>
+  std::vector<int> Called(E &event)
+  {
+    calls.clear();
+    event.Invoke();
+    return calls;
+  }
+
+  template<bool Ordered>
+  void UnhookSelf()
+  {
+    Event<void(), Ordered> event;
+    EVENT_HANDLE self = 0;
+    int count = 0;
+    self = event.Hook([&]() { ++count; event.Unhook(self); });
+    event.Hook([]() { calls.push_back(2); });
+
+    Called(event);
+    Called(event);
+    CHECK(count == 1);
+    CHECK(event.CallListSize() == 1);
+  }
+
+  template<bool Ordered>
+  void UnhookLater()
+  {
+    // A callback unhooked by an earlier one is skipped in the same invoke
+    Event<void(), Ordered> event;
+    EVENT_HANDLE first = 0, second = 0;
+    first = event.Hook([&]() { calls.push_back(1); event.Unhook(second); });
+    second = event.Hook([&]() { calls.push_back(2); event.Unhook(first); });
+
+    std::vector<int> called = Called(event);
+    CHECK(called.size() == 1);
+    CHECK(event.CallListSize() == 1);
+    CHECK(Called(event) == called);
+  }
+
+  template<bool Ordered>
+  void ClearDuringInvoke()
+  {
+    Event<void(), Ordered> event;
+    event.Hook([&]() { calls.push_back(1); event.Clear(); });
+    event.Hook([]() { calls.push_back(2); });
+    event.Hook([]() { calls.push_back(3); });
+    CHECK(Called(event).size() == 1);
+    CHECK(event.CallListSize() == 0);
+    CHECK(Called(event).empty());
+  }
+
+  void HookDuringInvoke()
+  {
+    // Callbacks hooked during an invoke are first called by the next one
+    Event<void()> event;
+    bool hooked = false;
+    event.Hook([&]()
+    {
+      calls.push_back(1);
+      if (!hooked) event.Hook([]() { calls.push_back(2); });
+      hooked = true;
+    });
+    CHECK((Called(event) == std::vector<int>{ 1 }));
+    CHECK(event.CallListSize() == 2);
+    CHECK((Called(event) == std::vector<int>{ 1, 2 }));
+  }
+
+  void HookAndUnhookDuringInvoke()
+  {
+    // A callback hooked and unhooked within the same invoke is never called
+    Event<void()> event;
+    event.Hook([&]() { event.Unhook(event.Hook([]() { calls.push_back(2); })); });
+    Called(event);
+    CHECK(Called(event).empty());
+    CHECK(event.CallListSize() == 1);
+  }
+
+  void NestedInvoke()
+  {
+    Event<void(int)> event;
+    std::vector<int> seen;
+    EVENT_HANDLE inner = 0;
+    event.Hook([&](int depth)
+    {
+      seen.push_back(depth);
+      if (depth == 0)
+      {
+        event.Unhook(inner);
+        event.Invoke(1);
+      }
+    });
+    inner = event.Hook([&](int depth) { seen.push_back(10 + depth); });
+
+    event.Invoke(0);
+    CHECK((seen == std::vector<int>{ 0, 1 }));
+    CHECK(event.CallListSize() == 1);
+  }
+}
+
+int main()
+{
+  UnhookSelf<true>();
+  UnhookSelf<false>();
+  UnhookLater<true>();
+  UnhookLater<false>();
+  ClearDuringInvoke<true>();
+  ClearDuringInvoke<false>();
+  HookDuringInvoke();
+  HookAndUnhookDuringInvoke();
+  NestedInvoke();
+  return test::Result();
+}
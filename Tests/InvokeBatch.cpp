@@ -0,0 +1,134 @@
+/*!
+ * \file InvokeBatch.cpp
+ * \brief
+ *      InvokeBatch calls batch callbacks once with every payload, other callbacks once per
+ *      payload in callback-outer order, one-shot callbacks with the first payload only, and
+ *      stops delivering to callbacks unhooked partway through.
+ */
+#include "Events.hpp"
+#include "Test.hpp"
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  using Payload = std::tuple<int, std::string>;
+
+  std::vector<Payload> Payloads(int count)
+  {
+    std::vector<Payload> payloads;
+    for (int i = 0; i < count; ++i)
+      payloads.emplace_back(i, std::to_string(i));
+    return payloads;
+  }
+
+  void BatchCallbackTakesWholeSpan()
+  {
+    Event<void(int, std::string)> event;
+    std::vector<std::pair<const Payload*, size_t>> batches;
+    event.HookBatch([&batches](const Payload *payloads, size_t count) { batches.emplace_back(payloads, count); });
+
+    std::vector<Payload> payloads = Payloads(5);
+    event.InvokeBatch(payloads);
+    CHECK(batches.size() == 1);
+    CHECK(batches[0].first == payloads.data() && batches[0].second == 5);
+
+    event.InvokeBatch(payloads.data() + 1, 2);
+    CHECK(batches.size() == 2);
+    CHECK(batches[1].first == payloads.data() + 1 && batches[1].second == 2);
+
+    // A single invoke reaches it as a batch of one
+    batches.clear();
+    event.Invoke(7, std::string("seven"));
+    CHECK(batches.size() == 1 && batches[0].second == 1);
+  }
+
+  void PerPayloadCallbacksOuter()
+  {
+    Event<void(int, std::string)> event;
+    std::vector<std::string> seen;
+    event.Hook([&seen](int i, const std::string &name) { seen.push_back("a" + std::to_string(i) + name); });
+    size_t batchCount = 0;
+    event.HookBatch([&](const Payload*, size_t count) { batchCount = count; seen.push_back("batch"); });
+    event.Hook([&seen](int i, std::string name) { seen.push_back("b" + std::to_string(i) + name); });
+
+    event.InvokeBatch(Payloads(3));
+    CHECK((seen == std::vector<std::string>{ "a00", "a11", "a22", "batch", "b00", "b11", "b22" }));
+    CHECK(batchCount == 3);
+  }
+
+  void OnceTakesFirstPayload()
+  {
+    Event<void(int, std::string)> event;
+    std::vector<int> once, persistent;
+    event.HookOnce([&once](int i, const std::string&) { once.push_back(i); });
+    event.Hook([&persistent](int i, const std::string&) { persistent.push_back(i); });
+
+    event.InvokeBatch(Payloads(4));
+    CHECK((once == std::vector<int>{ 0 }));
+    CHECK((persistent == std::vector<int>{ 0, 1, 2, 3 }));
+    CHECK(event.CallListSize() == 1);
+
+    event.InvokeBatch(Payloads(2));
+    CHECK(once.size() == 1);
+  }
+
+  void UnhookDuringBatch()
+  {
+    Event<void(int, std::string)> event;
+    std::vector<std::string> seen;
+    EVENT_HANDLE self = EVENT_HANDLE(0);
+    EVENT_HANDLE later = EVENT_HANDLE(0);
+    EVENT_HANDLE batch = EVENT_HANDLE(0);
+
+    // Unhooks itself at the second payload and the callbacks after it at the third
+    self = event.Hook([&](int i, const std::string&)
+    {
+      seen.push_back("self" + std::to_string(i));
+      if (i == 1) event.Unhook(self);
+    });
+    event.Hook([&](int i, const std::string&)
+    {
+      seen.push_back("other" + std::to_string(i));
+      if (i == 2)
+      {
+        event.Unhook(later);
+        event.Unhook(batch);
+      }
+    });
+    batch = event.HookBatch([&seen](const Payload*, size_t) { seen.push_back("batch"); });
+    later = event.Hook([&seen](int i, const std::string&) { seen.push_back("later" + std::to_string(i)); });
+
+    event.InvokeBatch(Payloads(4));
+    CHECK((seen == std::vector<std::string>{ "self0", "self1", "other0", "other1", "other2", "other3" }));
+    CHECK(event.CallListSize() == 1);
+
+    seen.clear();
+    event.InvokeBatch(Payloads(1));
+    CHECK((seen == std::vector<std::string>{ "other0" }));
+  }
+
+  void UnhookBatchByHandle()
+  {
+    Event<void(int, std::string)> event;
+    int batches = 0;
+    EVENT_HANDLE handle = event.HookBatch([&batches](const Payload*, size_t) { ++batches; });
+    event.InvokeBatch(Payloads(2));
+    event.Unhook(handle);
+    event.InvokeBatch(Payloads(2));
+    CHECK(batches == 1);
+    CHECK(event.CallListSize() == 0);
+  }
+}
+
+int main()
+{
+  BatchCallbackTakesWholeSpan();
+  PerPayloadCallbacksOuter();
+  OnceTakesFirstPayload();
+  UnhookDuringBatch();
+  UnhookBatchByHandle();
+  return test::Result();
+}
@@ -0,0 +1,149 @@
+/*!
+ * \file InvokeParallel.cpp
+ * \brief
+ *      InvokeParallel runs every live callback exactly once for any grain and thread count,
+ *      skips unhooked callbacks, calls one-shot callbacks once and unhooks them afterwards,
+ *      and EventThreadPool covers every index of a ParallelFor and shuts down cleanly.
+ */
+#include "Events.hpp"
+#include "Test.hpp"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace
+{
+  struct Counter
+  {
+    std::atomic<int> calls{0};
+    std::atomic<int> sum{0};
+    void Tick(int x) { ++calls; sum += x; }
+  };
+
+  const size_t threadCounts[] = { 1, 2, 4, 16 }; //!< Pool sizes, 16 is more threads than the small call lists
+  const size_t grains[] = { 1, 3, 64, 1000 };    //!< Chunk sizes, from one callback to the whole list
+
+  void ParallelForCoversRange()
+  {
+    for (size_t threads : threadCounts)
+    {
+      EventThreadPool pool(threads);
+      CHECK(pool.ThreadCount() == threads);
+      for (size_t grain : grains)
+        for (size_t count : { size_t(0), size_t(1), size_t(7), size_t(1000) })
+        {
+          std::vector<std::atomic<int>> seen(count);
+          std::atomic<int> bodies{0};
+          pool.ParallelFor(count, grain, [&](size_t begin, size_t end)
+          {
+            ++bodies;
+            for (size_t i = begin; i < end; ++i) ++seen[i];
+          });
+          bool once = true;
+          for (auto &index : seen) once = once && index.load() == 1;
+          CHECK(once);
+          CHECK(count != 0 || bodies.load() == 0);
+        }
+    }
+  }
+
+  template<bool Ordered>
+  void EveryCallbackOnce()
+  {
+    for (size_t threads : threadCounts)
+      for (size_t grain : grains)
+        for (size_t size : { size_t(1), size_t(5), size_t(500) })
+        {
+          EventThreadPool pool(threads);
+          Event<void(int), Ordered> event;
+          event.SetOrderIndependent(true);
+          event.SetParallelGrain(grain);
+          std::vector<Counter> counters(size);
+          for (Counter &counter : counters)
+            event.Hook(counter, &Counter::Tick);
+
+          event.InvokeParallel(pool, 2);
+          event.InvokeParallel(pool, 3);
+          bool once = true;
+          for (Counter &counter : counters)
+            once = once && counter.calls.load() == 2 && counter.sum.load() == 5;
+          CHECK(once);
+        }
+  }
+
+  void SkipsUnhooked()
+  {
+    EventThreadPool pool(4);
+    Event<void(int), false> event;
+    event.SetParallelGrain(7);
+    std::vector<Counter> counters(300);
+    std::vector<EVENT_HANDLE> handles;
+    for (Counter &counter : counters)
+      handles.push_back(event.Hook(counter, &Counter::Tick));
+    for (size_t i = 0; i < counters.size(); i += 3)
+      event.Unhook(handles[i]);
+
+    event.InvokeParallel(pool, 1);
+    bool skipped = true;
+    for (size_t i = 0; i < counters.size(); ++i)
+      skipped = skipped && counters[i].calls.load() == (i % 3 ? 1 : 0);
+    CHECK(skipped);
+    CHECK(event.CallListSize() == 200);
+  }
+
+  void OnceCalledThenUnhooked()
+  {
+    EventThreadPool pool(4);
+    Event<void(int), false> event;
+    event.SetParallelGrain(5);
+    std::vector<Counter> persistent(100), once(100);
+    for (size_t i = 0; i < persistent.size(); ++i)
+    {
+      event.Hook(persistent[i], &Counter::Tick);
+      event.HookOnce(once[i], &Counter::Tick);
+    }
+    CHECK(event.CallListSize() == 200);
+
+    event.InvokeParallel(pool, 1);
+    CHECK(event.CallListSize() == 100);
+    event.InvokeParallel(pool, 1);
+
+    bool counted = true;
+    for (size_t i = 0; i < persistent.size(); ++i)
+      counted = counted && persistent[i].calls.load() == 2 && once[i].calls.load() == 1;
+    CHECK(counted);
+  }
+
+  void PoolShutdown()
+  {
+    // Pools destroyed unused, right after a job while workers may still be looking for chunks,
+    // and after many jobs, all join their workers
+    for (int round = 0; round < 50; ++round)
+    {
+      { EventThreadPool idle(8); }
+
+      auto pool = std::make_unique<EventThreadPool>(8);
+      std::atomic<size_t> ran{0};
+      pool->ParallelFor(64, 1, [&ran](size_t begin, size_t end) { ran += end - begin; });
+      pool.reset();
+      CHECK(ran.load() == 64);
+    }
+
+    EventThreadPool pool(4);
+    std::atomic<size_t> ran{0};
+    for (int job = 0; job < 1000; ++job)
+      pool.ParallelFor(16, 2, [&ran](size_t begin, size_t end) { ran += end - begin; });
+    CHECK(ran.load() == 16000);
+  }
+}
+
+int main()
+{
+  ParallelForCoversRange();
+  EveryCallbackOnce<false>();
+  EveryCallbackOnce<true>();
+  SkipsUnhooked();
+  OnceCalledThenUnhooked();
+  PoolShutdown();
+  return test::Result();
+}
@@ -0,0 +1,92 @@
+/*!
+ * \file MoveToLast.cpp
+ * \brief
+ *      Counts the copies Invoke makes of its arguments: one per callback taking them by value,
+ *      one less with SetMoveToLast, none for callbacks taking them by const reference.
+ */
+#include "Events.hpp"
+#include "Test.hpp"
+
+namespace
+{
+  constexpr int Callbacks = 4; //!< Callbacks hooked to each event
+
+  //! Argument counting its copies and moves
+  struct Counted
+  {
+    static inline int copies = 0;
+    static inline int moves = 0;
+
+    Counted() = default;
+    Counted(const Counted&) { ++copies; }
+    Counted(Counted&&) noexcept { ++moves; }
+    Counted& operator=(const Counted&) { ++copies; return *this; }
+    Counted& operator=(Counted&&) noexcept { ++moves; return *this; }
+
+    static void Reset() { copies = moves = 0; }
+  };
+
+  void ByValue()
+  {
+    Event<void(Counted)> event;
+    for (int i = 0; i < Callbacks; ++i)
+      event.Hook([](Counted) {});
+
+    Counted::Reset();
+    event.Invoke(Counted());
+    CHECK(Counted::copies == Callbacks);
+
+    Counted lvalue;
+    Counted::Reset();
+    event.Invoke(lvalue);
+    CHECK(Counted::copies == Callbacks);
+  }
+
+  void ByValueMoveToLast()
+  {
+    Event<void(Counted)> event;
+    event.SetMoveToLast(true);
+    for (int i = 0; i < Callbacks; ++i)
+      event.Hook([](Counted) {});
+
+    Counted::Reset();
+    event.Invoke(Counted());
+    CHECK(Counted::copies == Callbacks - 1);
+
+    // Lvalues are never moved from
+    Counted lvalue;
+    Counted::Reset();
+    event.Invoke(lvalue);
+    CHECK(Counted::copies == Callbacks);
+
+    // The last live callback takes the move when the last hooked one is unhooked
+    EVENT_HANDLE last = event.Hook([](Counted) {});
+    event.Unhook(last);
+    Counted::Reset();
+    event.Invoke(Counted());
+    CHECK(Counted::copies == Callbacks - 1);
+  }
+
+  void ByConstReference()
+  {
+    Event<void(const Counted&)> event;
+    event.SetMoveToLast(true);
+    for (int i = 0; i < Callbacks; ++i)
+      event.Hook([](const Counted&) {});
+
+    Counted argument;
+    Counted::Reset();
+    event.Invoke(argument);
+    event.Invoke(Counted());
+    CHECK(Counted::copies == 0);
+    CHECK(Counted::moves == 0);
+  }
+}
+
+int main()
+{
+  ByValue();
+  ByValueMoveToLast();
+  ByConstReference();
+  return test::Result();
+}
@@ -0,0 +1,187 @@
+/*!
+ * \file Next.cpp
+ * \brief
+ *      Coroutines awaiting Event::Next are resumed after the callbacks, in the order they started
+ *      waiting, with their own copy of the arguments, and stop waiting when destroyed.
+ *      Built as C++20, skipped when the compiler has no coroutine support.
+ */
+#include "Events.hpp"
+#include "Test.hpp"
+
+#ifdef EVENT_COROUTINES
+#include <exception>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  //! Coroutine that starts eagerly and is destroyed by its owner
+  struct Task
+  {
+    struct promise_type
+    {
+      Task get_return_object() { return Task{ std::coroutine_handle<promise_type>::from_promise(*this) }; }
+      std::suspend_never initial_suspend() noexcept { return {}; }
+      std::suspend_always final_suspend() noexcept { return {}; }
+      void return_void() noexcept {}
+      void unhandled_exception() { std::terminate(); }
+    };
+
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+    Task(Task &&other) noexcept : handle(std::exchange(other.handle, {})) {}
+    Task(const Task&) = delete;
+    ~Task() { if (handle) handle.destroy(); }
+
+    [[nodiscard]] bool Done() const { return handle.done(); }
+
+    std::coroutine_handle<promise_type> handle;
+  };
+
+  std::vector<std::string> log; //!< Callbacks and coroutines in the order they ran
+
+  Task Wait(Event<void(std::string)> &event, std::string name, int times)
+  {
+    for (int i = 0; i < times; ++i)
+    {
+      std::string value = co_await event.Next();
+      log.push_back(name + ":" + value);
+    }
+  }
+
+  void ResumedAfterCallbacksInOrder()
+  {
+    log.clear();
+    Event<void(std::string)> event;
+    event.SetMoveToLast(true);
+    event.Hook([](std::string value) { log.push_back("callback:" + value); });
+
+    Task first = Wait(event, "first", 1);
+    Task second = Wait(event, "second", 2);
+    CHECK(event.WaiterCount() == 2);
+    CHECK(log.empty());
+
+    // The callback takes the argument by move, the waiters still see it
+    event.Invoke(std::string("a"));
+    CHECK((log == std::vector<std::string>{ "callback:a", "first:a", "second:a" }));
+    CHECK(first.Done() && !second.Done());
+
+    // The second coroutine waited again while resumed, so it waits for this invoke
+    CHECK(event.WaiterCount() == 1);
+    event.Invoke(std::string("b"));
+    CHECK(second.Done());
+    CHECK(event.WaiterCount() == 0);
+    CHECK(log.back() == "second:b");
+  }
+
+  Task WaitPair(Event<void(int, float)> &event, std::pair<int, float> &result)
+  {
+    auto [i, f] = co_await event.Next();
+    result = { i, f };
+  }
+
+  Task WaitEmpty(Event<void()> &event, int &resumed)
+  {
+    co_await event.Next();
+    ++resumed;
+  }
+
+  void Arities()
+  {
+    Event<void(int, float)> pair;
+    std::pair<int, float> result{};
+    Task task = WaitPair(pair, result);
+    pair.Invoke(3, 1.5f);
+    CHECK(result.first == 3 && result.second == 1.5f);
+
+    Event<void()> empty;
+    int resumed = 0;
+    Task a = WaitEmpty(empty, resumed), b = WaitEmpty(empty, resumed);
+    empty.Invoke();
+    CHECK(resumed == 2);
+  }
+
+  void DestroyedWhileWaiting()
+  {
+    log.clear();
+    Event<void(std::string)> event;
+    {
+      Task first = Wait(event, "first", 1);
+      Task second = Wait(event, "second", 1);
+      Task third = Wait(event, "third", 1);
+      CHECK(event.WaiterCount() == 3);
+      second.handle.destroy();
+      second.handle = {};
+      CHECK(event.WaiterCount() == 2);
+      event.Invoke(std::string("a"));
+      CHECK((log == std::vector<std::string>{ "first:a", "third:a" }));
+      Task fourth = Wait(event, "fourth", 1);
+    }
+    // Every waiting coroutine was destroyed and unlinked
+    CHECK(event.WaiterCount() == 0);
+    event.Invoke(std::string("b"));
+    CHECK(log.size() == 2);
+  }
+
+  void EventDestroyedFirst()
+  {
+    log.clear();
+    Task task = [] { auto *event = new Event<void(std::string)>(); Task waiting = Wait(*event, "orphan", 1); delete event; return waiting; }();
+    CHECK(!task.Done());
+    CHECK(log.empty());
+  }
+
+  //! Resumed by an invoke, it destroys another coroutine resumed by the same invoke
+  Task WaitAndDestroy(Event<void(std::string)> &event, std::coroutine_handle<> &victim)
+  {
+    co_await event.Next();
+    victim.destroy();
+  }
+
+  void DestroyedByEarlierWaiter()
+  {
+    log.clear();
+    Event<void(std::string)> event;
+    std::coroutine_handle<> victim;
+    Task destroyer = WaitAndDestroy(event, victim);
+    Task waiting = Wait(event, "victim", 1);
+    victim = std::exchange(waiting.handle, {});
+
+    event.Invoke(std::string("a"));
+    CHECK(destroyer.Done());
+    CHECK(log.empty());
+    CHECK(event.WaiterCount() == 0);
+  }
+
+  void QueueDispatchResumes()
+  {
+    // A dispatch with waiters invokes one queued invoke at a time, so each resumes them
+    log.clear();
+    EventQueue<void(std::string)> queue;
+    queue.Hook([](const std::string &value) { log.push_back("callback:" + value); });
+    Task waiting = Wait(queue, "queue", 2);
+    queue.Enqueue("a");
+    queue.Enqueue("b");
+
+    CHECK(queue.Dispatch() == 2);
+    CHECK((log == std::vector<std::string>{ "callback:a", "queue:a", "callback:b", "queue:b" }));
+    CHECK(waiting.Done());
+  }
+}
+
+int main()
+{
+  ResumedAfterCallbacksInOrder();
+  Arities();
+  DestroyedWhileWaiting();
+  EventDestroyedFirst();
+  DestroyedByEarlierWaiter();
+  QueueDispatchResumes();
+  return test::Result();
+}
+#else
+int main()
+{
+  return 77; // Skipped, see SKIP_RETURN_CODE
+}
+#endif
@@ -0,0 +1,102 @@
+/*!
+ * \file Order.cpp
+ * \brief
+ *      Ordered events call back in hook order through any unhooks, unordered events call every
+ *      callback exactly once.
+ */
+#include "Events.hpp"
+#include "Test.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+  std::vector<int> calls; //!< Ids of the callbacks called, in call order
+
+  template<typename E>
+  std::vector<int> Called(E &event)
+  {
+    calls.clear();
+    event.Invoke();
+    return calls;
+  }
+
+  template<typename E>
+  EVENT_HANDLE HookId(E &event, int id)
+  {
+    return event.Hook([id]() { calls.push_back(id); });
+  }
+
+  void OrderedKeepsHookOrder()
+  {
+    Event<void()> event;
+    std::vector<EVENT_HANDLE> handles;
+    std::vector<int> expected;
+    for (int i = 0; i < 64; ++i)
+    {
+      handles.push_back(HookId(event, i));
+      expected.push_back(i);
+    }
+    CHECK(Called(event) == expected);
+
+    // Unhook a random half, the rest keep their order
+    std::mt19937 random(42);
+    std::vector<int> order(expected);
+    std::shuffle(order.begin(), order.end(), random);
+    for (size_t i = 0; i < order.size() / 2; ++i)
+    {
+      event.Unhook(handles[size_t(order[i])]);
+      expected.erase(std::find(expected.begin(), expected.end(), order[i]));
+      CHECK(Called(event) == expected);
+    }
+
+    // New hooks go last
+    HookId(event, 100);
+    expected.push_back(100);
+    CHECK(Called(event) == expected);
+  }
+
+  void UnorderedCallsEachOnce()
+  {
+    Event<void(), false> event;
+    std::vector<EVENT_HANDLE> handles;
+    std::vector<int> expected;
+    for (int i = 0; i < 64; ++i)
+    {
+      handles.push_back(HookId(event, i));
+      expected.push_back(i);
+    }
+
+    std::mt19937 random(7);
+    std::vector<int> order(expected);
+    std::shuffle(order.begin(), order.end(), random);
+    for (size_t i = 0; i < order.size() / 2; ++i)
+    {
+      event.Unhook(handles[size_t(order[i])]);
+      expected.erase(std::find(expected.begin(), expected.end(), order[i]));
+      std::vector<int> called = Called(event);
+      std::sort(called.begin(), called.end());
+      CHECK(called == expected);
+    }
+  }
+
+  void PriorityOrder()
+  {
+    Event<void()> event;
+    event.Hook(0, []() { calls.push_back(3); });
+    event.Hook(10, []() { calls.push_back(1); });
+    event.Hook(-5, []() { calls.push_back(5); });
+    event.Hook([]() { calls.push_back(4); });
+    event.Hook(10, []() { calls.push_back(2); });
+    CHECK((Called(event) == std::vector<int>{ 1, 2, 3, 4, 5 }));
+  }
+}
+
+int main()
+{
+  OrderedKeepsHookOrder();
+  UnorderedCallsEachOnce();
+  PriorityOrder();
+  return test::Result();
+}
@@ -0,0 +1,95 @@
+/*!
+ * \file Priority.cpp
+ * \brief
+ *      Hook with a priority of any integer or enumeration type orders callbacks by descending
+ *      priority, stable within a priority, for functions and methods.
+ */
+#include "Events.hpp"
+#include "Test.hpp"
+#include <vector>
+
+namespace
+{
+  std::vector<int> calls; //!< Ids of the callbacks called, in call order
+
+  template<typename E>
+  std::vector<int> Called(E &event)
+  {
+    calls.clear();
+    event.Invoke();
+    return calls;
+  }
+
+  enum class Layer : uint8_t { Ui = 1, Gameplay = 5, Input = 9 };
+  enum Plain { Low = -3, High = 3 };
+
+  struct Object
+  {
+    int id = 0;
+    void Call() { calls.push_back(id); }
+  };
+
+  void IntegerTypes()
+  {
+    Event<void()> event;
+    size_t large = 100;
+    long negative = -100;
+    int32_t lvalue = 50;
+    const short constant = 10;
+    event.Hook([]() { calls.push_back(4); });
+    event.Hook(large, []() { calls.push_back(1); });
+    event.Hook(negative, []() { calls.push_back(6); });
+    event.Hook(lvalue, []() { calls.push_back(2); });
+    event.Hook(constant, []() { calls.push_back(3); });
+    event.Hook(uint8_t(0), []() { calls.push_back(5); });
+    CHECK((Called(event) == std::vector<int>{ 1, 2, 3, 4, 5, 6 }));
+  }
+
+  void EnumerationTypes()
+  {
+    Event<void()> event;
+    event.Hook(Layer::Ui, []() { calls.push_back(3); });
+    event.Hook(Layer::Input, []() { calls.push_back(1); });
+    event.Hook(Layer::Gameplay, []() { calls.push_back(2); });
+    event.Hook(Low, []() { calls.push_back(5); });
+    event.Hook(High, []() { calls.push_back(4); });
+    CHECK((Called(event) == std::vector<int>{ 1, 2, 4, 3, 5 }));
+  }
+
+  void Methods()
+  {
+    Event<void()> event;
+    Object first{ 1 }, second{ 2 }, third{ 3 };
+    size_t priority = 7;
+    event.Hook(third, &Object::Call);
+    event.Hook(Layer::Input, second, &Object::Call);
+    event.Hook(priority, first, &Object::Call);
+    CHECK((Called(event) == std::vector<int>{ 2, 1, 3 }));
+
+    event.UnhookClass(second);
+    CHECK((Called(event) == std::vector<int>{ 1, 3 }));
+  }
+
+  void StableWithinPriority()
+  {
+    Event<void()> event;
+    for (int i = 0; i < 20; ++i)
+    {
+      int id = i;
+      event.Hook(long(i % 2), [id]() { calls.push_back(id); });
+    }
+    std::vector<int> expected;
+    for (int i = 1; i < 20; i += 2) expected.push_back(i);
+    for (int i = 0; i < 20; i += 2) expected.push_back(i);
+    CHECK(Called(event) == expected);
+  }
+}
+
+int main()
+{
+  IntegerTypes();
+  EnumerationTypes();
+  Methods();
+  StableWithinPriority();
+  return test::Result();
+}
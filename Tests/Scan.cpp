@@ -0,0 +1,84 @@
+/*!
+ * \file Scan.cpp
+ * \brief
+ *      Each EventScan kernel the CPU supports finds the same flag as the scalar kernel, at every
+ *      offset and length around the vector widths, and compaction keeps the live calls in order.
+ */
+#include "Events.hpp"
+#include "Test.hpp"
+#include <random>
+#include <vector>
+
+namespace
+{
+  //! Compares a kernel to the scalar one over every range of a buffer
+  void MatchesScalar(EventScan::Kernel kernel, const std::vector<uint8_t> &flags)
+  {
+    for (size_t first = 0; first < 70; ++first)
+      for (size_t last = first; last <= flags.size(); ++last)
+        for (uint8_t value : { uint8_t(0), uint8_t(1) })
+          if (kernel(flags.data(), first, last, 1, value) != EventScan::FindScalar(flags.data(), first, last, 1, value))
+          {
+            CHECK(!"kernel differs from the scalar kernel");
+            return;
+          }
+  }
+
+  void KernelsMatch()
+  {
+    std::vector<EventScan::Kernel> kernels{ &EventScan::Find };
+#ifdef EVENT_SIMD_X86
+    kernels.push_back(&EventScan::FindSse2);
+    if (__builtin_cpu_supports("avx2")) kernels.push_back(&EventScan::FindAvx2);
+#endif
+
+    // Sparse, dense and single removed flags, with other bits set that the mask ignores
+    std::mt19937 random(3);
+    for (unsigned density : { 2u, 10u, 90u })
+    {
+      std::vector<uint8_t> flags(200);
+      for (uint8_t &flag : flags)
+        flag = uint8_t((random() % 100 < density ? 1 : 0) | (random() % 2 ? 6 : 0));
+      for (EventScan::Kernel kernel : kernels)
+        MatchesScalar(kernel, flags);
+    }
+
+    std::vector<uint8_t> single(200, 4);
+    single[133] = 5;
+    for (EventScan::Kernel kernel : kernels)
+    {
+      CHECK(kernel(single.data(), 0, single.size(), 1, 1) == 133);
+      CHECK(kernel(single.data(), 134, single.size(), 1, 1) == single.size());
+      CHECK(kernel(single.data(), 0, 133, 1, 1) == 133);
+    }
+  }
+
+  void CompactKeepsOrder()
+  {
+    // Unhooks runs long enough for the vector kernels to skip, then checks the order left
+    Event<void(std::vector<int>&)> event;
+    std::vector<EVENT_HANDLE> handles;
+    for (int i = 0; i < 1000; ++i)
+      handles.push_back(event.Hook([i](std::vector<int> &called) { called.push_back(i); }));
+
+    std::vector<EVENT_HANDLE> removed;
+    std::vector<int> expected;
+    for (int i = 0; i < 1000; ++i)
+      if ((i / 37) % 3 == 1 || i % 101 == 0)
+        removed.push_back(handles[size_t(i)]);
+      else
+        expected.push_back(i);
+    event.UnhookRange(removed.begin(), removed.end());
+
+    std::vector<int> called;
+    event.Invoke(called);
+    CHECK(called == expected);
+  }
+}
+
+int main()
+{
+  KernelsMatch();
+  CompactKeepsOrder();
+  return test::Result();
+}
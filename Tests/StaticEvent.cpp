@@ -0,0 +1,97 @@
+/*!
+ * \file StaticEvent.cpp
+ * \brief
+ *      StaticEvent calls its compile time bound functions, static methods and StaticMethod
+ *      bindings in the order they are listed, with the arguments of the invoke.
+ */
+#include "Events.hpp"
+#include "Test.hpp"
+#include <string>
+#include <vector>
+
+namespace
+{
+  std::vector<std::string> calls; //!< Callbacks called, with their arguments, in call order
+
+  void First(int value, const std::string &name)
+  {
+    calls.push_back("first:" + std::to_string(value) + name);
+  }
+
+  void Second(int value, const std::string &name)
+  {
+    calls.push_back("second:" + std::to_string(value) + name);
+  }
+
+  struct Object
+  {
+    std::string id;
+    int total = 0;
+
+    void Method(int value, const std::string &name)
+    {
+      total += value;
+      calls.push_back(id + ":" + std::to_string(value) + name);
+    }
+
+    void ConstMethod(int value, const std::string &name) const
+    {
+      calls.push_back(id + " const:" + std::to_string(value) + name);
+    }
+
+    static void Static(int value, const std::string &name)
+    {
+      calls.push_back("static:" + std::to_string(value) + name);
+    }
+  };
+
+  Object left{ "left" };   //!< Objects bound by StaticMethod need static storage duration
+  Object right{ "right" };
+
+  using Ordered = StaticEvent<void(int, const std::string&), &Second, &First, &Object::Static>;
+  using Methods = StaticEvent<void(int, const std::string&), StaticMethod<&Object::Method, &left>, &First,
+                              StaticMethod<&Object::Method, &right>, StaticMethod<&Object::ConstMethod, &left>>;
+  using Empty = StaticEvent<void(int, const std::string&)>;
+
+  static_assert(Ordered::CallListSize() == 3);
+  static_assert(Methods::CallListSize() == 4);
+  static_assert(Empty::CallListSize() == 0);
+
+  void FunctionsInOrder()
+  {
+    calls.clear();
+    std::string name = "a";
+    Ordered::Invoke(1, name);
+    CHECK((calls == std::vector<std::string>{ "second:1a", "first:1a", "static:1a" }));
+
+    calls.clear();
+    Ordered::Invoke(2, std::string("b"));
+    CHECK((calls == std::vector<std::string>{ "second:2b", "first:2b", "static:2b" }));
+  }
+
+  void MethodsOnTheirObjects()
+  {
+    calls.clear();
+    Methods::Invoke(5, "x");
+    CHECK((calls == std::vector<std::string>{ "left:5x", "first:5x", "right:5x", "left const:5x" }));
+    CHECK(left.total == 5 && right.total == 5);
+
+    Methods::Invoke(2, "y");
+    CHECK(left.total == 7 && right.total == 7);
+  }
+
+  void NoCallbacks()
+  {
+    calls.clear();
+    Empty::Invoke(1, "z");
+    CHECK(calls.empty());
+  }
+}
+
+int main()
+{
+  FunctionsInOrder();
+  MethodsOnTheirObjects();
+  NoCallbacks();
+  return test::Result();
+}
@@ -0,0 +1,30 @@
+/*!
+ * \file Test.hpp
+ * \brief
+ *      Checks shared by the tests. Each test is its own program: CHECK reports a failed
+ *      condition and keeps going, main returns Result() so CTest sees the failure.
+ *      Checks stay on in Release builds, unlike assert.
+ */
+#ifndef EVENTS_TEST_HPP
+#define EVENTS_TEST_HPP
+#pragma once
+
+#include <cstdio>
+
+namespace test
+{
+  inline int failures = 0; //!< Checks failed so far
+
+  //! Exit code of the test program
+  inline int Result()
+  {
+    if (failures) std::fprintf(stderr, "%d check(s) failed\n", failures);
+    return failures ? 1 : 0;
+  }
+}
+
+//! Reports the condition with its location if it is false
+#define CHECK(condition) \
+  ((condition) ? (void)0 : (void)(++test::failures, std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition)))
+
+#endif // EVENTS_TEST_HPP
@@ -0,0 +1,182 @@
+/*!
+ * \file Unhook.cpp
+ * \brief
+ *      Unhooking by function, by handle, by class and by cluster, and stale handles.
+ */
+#include "Events.hpp"
+#include "Test.hpp"
+#include <vector>
+
+namespace
+{
+  std::vector<int> calls; //!< Ids of the callbacks called, in call order
+
+  void A(int) { calls.push_back(1); }
+  void B(int) { calls.push_back(2); }
+  void C(int) { calls.push_back(3); }
+
+  struct Object
+  {
+    int id = 0;
+    void First(int) { calls.push_back(id * 10 + 1); }
+    void Second(int) { calls.push_back(id * 10 + 2); }
+    void Third(int) { calls.push_back(id * 10 + 3); }
+  };
+
+  //! Invokes an event and returns the ids of the callbacks called
+  template<typename E>
+  std::vector<int> Called(E &event)
+  {
+    calls.clear();
+    event.Invoke(0);
+    return calls;
+  }
+
+  template<bool Ordered>
+  void UnhookByFunction()
+  {
+    Event<void(int), Ordered> event;
+    Object object{ 1 };
+    event.Hook(A);
+    event.Hook(B);
+    event.Hook(object, &Object::First);
+    event.Hook(object, &Object::Second);
+
+    event.Unhook(A);
+    event.Unhook(object, &Object::Second);
+    CHECK(event.CallListSize() == 2);
+    std::vector<int> called = Called(event);
+    std::sort(called.begin(), called.end());
+    CHECK((called == std::vector<int>{ 2, 11 }));
+
+    // Unhooking what is not hooked does nothing
+    event.Unhook(A);
+    event.Unhook(C);
+    CHECK(event.CallListSize() == 2);
+  }
+
+  template<bool Ordered>
+  void UnhookByHandle()
+  {
+    Event<void(int), Ordered> event;
+    int lambda = 0;
+    EVENT_HANDLE a = event.Hook(A);
+    EVENT_HANDLE captured = event.Hook([&lambda](int) { ++lambda; });
+    event.Hook(B);
+
+    event.Unhook(captured);
+    event.Unhook(a);
+    CHECK(event.CallListSize() == 1);
+    CHECK((Called(event) == std::vector<int>{ 2 }));
+    CHECK(lambda == 0);
+  }
+
+  template<bool Ordered>
+  void StaleHandles()
+  {
+    Event<void(int), Ordered> event;
+    EVENT_HANDLE a = event.Hook(A);
+    event.Unhook(a);
+
+    // The slot is reused by the next hook, the old handle must not reach it
+    EVENT_HANDLE b = event.Hook(B);
+    CHECK(a != b);
+    CHECK(GET_ID(a) == GET_ID(b));
+    event.Unhook(a);
+    CHECK(event.CallListSize() == 1);
+    CHECK((Called(event) == std::vector<int>{ 2 }));
+
+    // Handles of unhooked functions stay stale after many reuses
+    for (int i = 0; i < 100; ++i)
+      event.Unhook(event.Hook(C));
+    event.Unhook(a);
+    event.Unhook(b);
+    CHECK(event.CallListSize() == 0);
+    event.Unhook(b);
+    CHECK(event.CallListSize() == 0);
+  }
+
+  template<bool Ordered>
+  void UnhookClass()
+  {
+    Event<void(int), Ordered> event;
+    Object first{ 1 }, second{ 2 };
+    event.Hook(first, &Object::First);
+    event.Hook(second, &Object::First);
+    event.Hook(A);
+    event.Hook(first, &Object::Second);
+    event.Hook(second, &Object::Second);
+
+    event.UnhookClass(first);
+    CHECK(event.CallListSize() == 3);
+    std::vector<int> called = Called(event);
+    std::sort(called.begin(), called.end());
+    CHECK((called == std::vector<int>{ 1, 21, 22 }));
+
+    event.UnhookClass(first);
+    event.UnhookClass(second);
+    CHECK((Called(event) == std::vector<int>{ 1 }));
+  }
+
+  template<bool Ordered>
+  void UnhookClusters()
+  {
+    Event<void(int), Ordered> event;
+    Object object{ 1 };
+    EVENT_HANDLE functions = event.HookFunctionCluster(A, B);
+    EVENT_HANDLE methods = event.HookMethodCluster(object, &Object::First, &Object::Third);
+    event.Hook(C);
+    CHECK(GET_CLUSTER(functions) && GET_CLUSTER(methods) && functions != methods);
+    CHECK(event.CallListSize() == 5);
+
+    // A cluster handle does not unhook through Unhook, only through UnhookCluster
+    event.Unhook(functions);
+    CHECK(event.CallListSize() == 5);
+
+    event.UnhookCluster(functions);
+    std::vector<int> called = Called(event);
+    std::sort(called.begin(), called.end());
+    CHECK((called == std::vector<int>{ 3, 11, 13 }));
+
+    event.UnhookCluster(methods);
+    event.UnhookCluster(methods);
+    CHECK((Called(event) == std::vector<int>{ 3 }));
+  }
+
+  template<bool Ordered>
+  void UnhookLists()
+  {
+    Event<void(int), Ordered> event;
+    Object object{ 1 };
+    event.Hook(A);
+    event.Hook(B);
+    event.Hook(C);
+    event.Hook(object, &Object::First);
+    event.Hook(object, &Object::Second);
+    event.Hook(object, &Object::Third);
+
+    event.UnhookFunctions(A, C);
+    event.UnhookMethods(object, &Object::First, &Object::Third);
+    std::vector<int> called = Called(event);
+    std::sort(called.begin(), called.end());
+    CHECK((called == std::vector<int>{ 2, 12 }));
+  }
+
+  template<bool Ordered>
+  void RunAll()
+  {
+    UnhookByFunction<Ordered>();
+    UnhookByHandle<Ordered>();
+    StaleHandles<Ordered>();
+    UnhookClass<Ordered>();
+    UnhookClusters<Ordered>();
+    UnhookLists<Ordered>();
+  }
+}
+
+int main()
+{
+  RunAll<true>();
+  RunAll<false>();
+  return test::Result();
+}